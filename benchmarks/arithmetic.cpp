@@ -0,0 +1,148 @@
+// Times BigInteger add, sub, mul, div, mod, toString and parse on operands of 1 limb up to 10^6 decimal digits,
+// and Rational sum, product and compare chains, and prints the results as JSON for tracking regressions.
+// Division and mod take a dividend of twice the digits. An optional argument caps the digits.
+//
+//     g++ -std=c++20 -O2 -pthread benchmarks/arithmetic.cpp -o arithmetic
+//     ./arithmetic [max_digits] > arithmetic.json
+
+#include "../biginteger.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+
+constexpr double min_measure_seconds = 0.05;
+constexpr size_t digit_counts[] = {19, 50, 100, 300, 1000, 3000, 10000, 30000, 100000, 300000, 1000000};
+constexpr size_t rational_chain_length = 2000;
+constexpr size_t rational_term_digits[] = {1, 10, 19, 40};
+
+std::string random_digits(size_t digits, std::mt19937_64& generator) {
+    std::string result(digits, '0');
+    for (char& digit : result) {
+        digit = static_cast<char>('0' + generator() % 10);
+    }
+    result[0] = static_cast<char>('1' + generator() % 9);
+    return result;
+}
+
+BigInteger random_number(size_t digits, std::mt19937_64& generator) {
+    return BigInteger(random_digits(digits, generator));
+}
+
+// mean seconds per call of f, repeated until min_measure_seconds have passed
+template<typename F>
+double seconds_per_call(F f) {
+    auto begin = std::chrono::steady_clock::now();
+    size_t iterations = 0;
+    double elapsed = 0;
+    do {
+        f();
+        ++iterations;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    } while (elapsed < min_measure_seconds);
+    return elapsed / static_cast<double>(iterations);
+}
+
+class JsonResults {
+
+private:
+
+    bool is_first = true;
+
+public:
+
+    JsonResults() {
+        std::cout << "{\"results\": [";
+    }
+
+    ~JsonResults() {
+        std::cout << "\n]}\n";
+    }
+
+    void add(const char* operation, const char* size_name, size_t size, double seconds) {
+        std::cout << (is_first ? "\n" : ",\n") << "  {\"operation\": \"" << operation << "\", \"" << size_name
+                  << "\": " << size << ", \"seconds\": " << seconds << "}";
+        std::cout.flush();
+        is_first = false;
+    }
+
+};
+
+void benchmark_integers(JsonResults& results, size_t max_digits, std::mt19937_64& generator) {
+    for (size_t digits : digit_counts) {
+        if (digits > max_digits) {
+            break;
+        }
+        BigInteger a = random_number(digits, generator);
+        BigInteger b = random_number(digits, generator);
+        BigInteger dividend = random_number(2 * digits, generator);
+        std::string text = a.toString();
+        BigInteger sink;
+
+        results.add("add", "digits", digits, seconds_per_call([&]() {
+            sink = a + b;
+        }));
+        results.add("sub", "digits", digits, seconds_per_call([&]() {
+            sink = a - b;
+        }));
+        results.add("mul", "digits", digits, seconds_per_call([&]() {
+            sink = a * b;
+        }));
+        results.add("div", "digits", digits, seconds_per_call([&]() {
+            sink = dividend / b;
+        }));
+        results.add("mod", "digits", digits, seconds_per_call([&]() {
+            sink = dividend % b;
+        }));
+        results.add("toString", "digits", digits, seconds_per_call([&]() {
+            text = a.toString();
+        }));
+        results.add("parse", "digits", digits, seconds_per_call([&]() {
+            sink = BigInteger(text);
+        }));
+    }
+}
+
+// chains of rational_chain_length terms p / q with term_digits digits each
+void benchmark_rationals(JsonResults& results, std::mt19937_64& generator) {
+    for (size_t term_digits : rational_term_digits) {
+        std::vector<Rational> terms;
+        for (size_t i = 0; i < rational_chain_length; ++i) {
+            terms.push_back(Rational(random_number(term_digits, generator)) / Rational(random_number(term_digits, generator)));
+        }
+
+        Rational sink;
+        size_t less = 0;
+
+        results.add("rational_sum_chain", "term_digits", term_digits, seconds_per_call([&]() {
+            Rational sum;
+            for (const Rational& term : terms) {
+                sum += term;
+            }
+            sink = sum;
+        }));
+        results.add("rational_product_chain", "term_digits", term_digits, seconds_per_call([&]() {
+            Rational product = 1;
+            for (const Rational& term : terms) {
+                product *= term;
+            }
+            sink = product;
+        }));
+        results.add("rational_compare_chain", "term_digits", term_digits, seconds_per_call([&]() {
+            for (size_t i = 0; i + 1 < terms.size(); ++i) {
+                less += static_cast<size_t>(terms[i] < terms[i + 1]);
+            }
+        }));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t max_digits = (argc > 1 ? static_cast<size_t>(std::stoull(argv[1])) : static_cast<size_t>(-1));
+    std::mt19937_64 generator(2024);
+    JsonResults results;
+    benchmark_integers(results, max_digits, generator);
+    benchmark_rationals(results, generator);
+}
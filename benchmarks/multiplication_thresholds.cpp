@@ -0,0 +1,78 @@
+// Finds the operand sizes (in 64-bit limbs) from which each BigInteger multiplication kernel
+// beats the previous one on this machine and prints them in BigInteger::MultiplicationThresholds order.
+//
+//     g++ -std=c++20 -O2 benchmarks/multiplication_thresholds.cpp -o multiplication_thresholds
+//     ./multiplication_thresholds
+
+#include "../biginteger.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+
+constexpr size_t never = static_cast<size_t>(-1);
+constexpr double digits_per_limb = 19.27;
+constexpr double min_measure_seconds = 0.02;
+constexpr double size_step = 1.15;
+
+BigInteger random_number(size_t limbs, std::mt19937_64& generator) {
+    std::string digits(static_cast<size_t>(static_cast<double>(limbs) * digits_per_limb), '0');
+    for (char& digit : digits) {
+        digit = static_cast<char>('0' + generator() % 10);
+    }
+    digits[0] = '9';
+    return BigInteger(digits);
+}
+
+double seconds_per_multiplication(const BigInteger& a, const BigInteger& b) {
+    auto begin = std::chrono::steady_clock::now();
+    size_t iterations = 0;
+    double elapsed = 0;
+    do {
+        BigInteger product = a;
+        product *= b;
+        ++iterations;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    } while (elapsed < min_measure_seconds);
+    return elapsed / static_cast<double>(iterations);
+}
+
+// the first size where the kernel switched on by `threshold` wins twice in a row
+size_t find_crossover(size_t& threshold, size_t from, size_t to, std::mt19937_64& generator) {
+    size_t candidate = never;
+    for (size_t size = from; size <= to; size = std::max(size + 1, static_cast<size_t>(static_cast<double>(size) * size_step))) {
+        BigInteger a = random_number(size, generator);
+        BigInteger b = random_number(size, generator);
+        threshold = never;
+        double old_time = seconds_per_multiplication(a, b);
+        threshold = size;
+        double new_time = seconds_per_multiplication(a, b);
+        if (new_time < old_time) {
+            if (candidate != never) {
+                return candidate;
+            }
+            candidate = size;
+        } else {
+            candidate = never;
+        }
+    }
+    return to;
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937_64 generator(2024);
+    BigInteger::MultiplicationThresholds& thresholds = BigInteger::multiplication_thresholds();
+    thresholds = {never, never, never};
+
+    size_t karatsuba = find_crossover(thresholds.karatsuba, 4, 512, generator);
+    thresholds.karatsuba = karatsuba;
+    size_t toom3 = find_crossover(thresholds.toom3, std::max<size_t>(karatsuba, 9), 4096, generator);
+    thresholds.toom3 = toom3;
+    size_t ntt = find_crossover(thresholds.ntt, toom3, 262144, generator);
+    thresholds.ntt = ntt;
+
+    std::cout << "{\"karatsuba\": " << karatsuba << ", \"toom3\": " << toom3 << ", \"ntt\": " << ntt << "}\n";
+}
@@ -4,781 +4,5265 @@
 #include <algorithm>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstring>
+#include <cstdint>
 #include <compare>
-#include <complex>
-#include <math.h>
+#include <bit>
+#include <utility>
+#include <mutex>
+#include <charconv>
+#include <initializer_list>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <span>
+#include <cstddef>
+#include <cmath>
+#include <random>
+#include <optional>
+#include <array>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(BIGINTEGER_NO_SIMD)
+#define BIGINTEGER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// Worker threads that split a loop of independent tasks with the calling thread. The pool grows on demand,
+// loops started from a worker or while another loop is running go serially, so nested loops cannot deadlock.
+class ThreadPool {
+
+private:
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::mutex loop_mutex;    // held by the thread that runs the current loop
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(size_t)>* task = nullptr;
+    size_t task_count = 0;
+    std::atomic<size_t> next_task = 0;
+    size_t free_slots = 0;    // workers that may still join the current loop
+    size_t busy_workers = 0;    // workers that have not seen the end of the current loop
+    size_t generation = 0;
+    bool is_stopping = false;
+    std::exception_ptr error;
+
+    static bool& is_worker() {
+        thread_local bool worker = false;
+        return worker;
+    }
+
+    void run_tasks() {
+        for (size_t i = next_task++; i < task_count; i = next_task++) {
+            try {
+                (*task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    void work(size_t seen_generation) {
+        is_worker() = true;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this, seen_generation]() {
+                return is_stopping || generation != seen_generation;
+            });
+            if (is_stopping) {
+                return;
+            }
+            seen_generation = generation;
+            if (free_slots > 0) {
+                --free_slots;
+                lock.unlock();
+                run_tasks();
+                lock.lock();
+            }
+            if (--busy_workers == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+public:
+
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // calls f(0), ..., f(count - 1) on up to threads threads and rethrows the first exception of a task
+    template<typename F>
+    void parallel_for(size_t count, size_t threads, F&& f) {
+        std::unique_lock<std::mutex> loop_lock(loop_mutex, std::defer_lock);
+        if (count <= 1 || threads <= 1 || is_worker() || !loop_lock.try_lock()) {
+            for (size_t i = 0; i < count; ++i) {
+                f(i);
+            }
+            return;
+        }
+        std::function<void(size_t)> function = std::ref(f);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (workers.size() + 1 < threads) {
+                workers.emplace_back(&ThreadPool::work, this, generation);
+            }
+            task = &function;
+            task_count = count;
+            next_task = 0;
+            free_slots = std::min(threads, count) - 1;
+            busy_workers = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+        run_tasks();
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() {
+            return busy_workers == 0;
+        });
+        task = nullptr;
+        if (error) {
+            std::exception_ptr task_error = error;
+            error = nullptr;
+            std::rethrow_exception(task_error);
+        }
+    }
+
+};
+
+// Thread-local cache of freed buffers for limbs and transform temporaries. Requests are rounded up to classes of
+// 2^k, 1.25 * 2^k, 1.5 * 2^k and 1.75 * 2^k bytes, and a released block waits in its class for the next request
+// on the same thread, so repeated operations stop going back to the allocator and faulting in fresh pages.
+// Blocks may be released on any thread; past the limit of a thread they go back to the allocator.
+class ScratchArena {
+
+private:
+
+    constexpr static size_t min_block_bytes = 64;
+    constexpr static size_t class_count = 4 * 64;
+
+    struct Cache {
+        std::vector<void*> blocks[class_count];
+        size_t cached_bytes = 0;
+
+        ~Cache() {
+            for (std::vector<void*>& list : blocks) {
+                for (void* block : list) {
+                    ::operator delete(block);
+                }
+            }
+            is_destroyed() = true;
+        }
+    };
+
+    // set when the cache of the thread is gone, blocks of later thread_local destructors go straight back
+    static bool& is_destroyed() {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    static Cache& cache() {
+        thread_local Cache current;
+        return current;
+    }
+
+    static size_t size_class(size_t bytes, size_t& class_bytes) {
+        size_t top = std::max(bytes, min_block_bytes) - 1;
+        size_t exponent = static_cast<size_t>(std::bit_width(top)) - 1;
+        size_t quarters = top >> (exponent - 2);
+        class_bytes = (quarters + 1) << (exponent - 2);
+        return 4 * exponent + quarters - 4;
+    }
+
+public:
+
+    // bytes of free blocks each thread may keep
+    struct Limits {
+        size_t cached_bytes = size_t(64) << 20;
+    };
+
+    static Limits& limits() {
+        static Limits settings;
+        return settings;
+    }
+
+    // a block of at least bytes bytes, block_bytes is set to its whole size
+    static void* allocate(size_t bytes, size_t& block_bytes) {
+        size_t index = size_class(bytes, block_bytes);
+        if (!is_destroyed()) {
+            Cache& current = cache();
+            if (!current.blocks[index].empty()) {
+                void* block = current.blocks[index].back();
+                current.blocks[index].pop_back();
+                current.cached_bytes -= block_bytes;
+                return block;
+            }
+        }
+        return ::operator new(block_bytes);
+    }
+
+    // block_bytes must be the size given by allocate
+    static void release(void* block, size_t block_bytes) {
+        if (!is_destroyed()) {
+            Cache& current = cache();
+            if (current.cached_bytes + block_bytes <= limits().cached_bytes) {
+                current.blocks[size_class(block_bytes, block_bytes)].push_back(block);
+                current.cached_bytes += block_bytes;
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    // returns the free blocks of the calling thread to the allocator
+    static void trim() {
+        if (is_destroyed()) {
+            return;
+        }
+        Cache& current = cache();
+        for (std::vector<void*>& list : current.blocks) {
+            for (void* block : list) {
+                ::operator delete(block);
+            }
+            list.clear();
+        }
+        current.cached_bytes = 0;
+    }
+
+    // uninitialized array of a trivial type in a block of the arena
+    template<typename T>
+    class Buffer {
+    private:
+        T* begin_ = nullptr;
+        size_t size_ = 0;
+        size_t block_bytes_ = 0;
+
+    public:
+        Buffer() = default;
+
+        explicit Buffer(size_t size): size_(size) {
+            if (size != 0) {
+                begin_ = static_cast<T*>(allocate(size * sizeof(T), block_bytes_));
+            }
+        }
+
+        Buffer(size_t size, T value): Buffer(size) {
+            std::fill(begin_, begin_ + size_, value);
+        }
+
+        Buffer(const Buffer& other) = delete;
+        Buffer& operator=(const Buffer& other) = delete;
+
+        Buffer(Buffer&& other) noexcept: begin_(std::exchange(other.begin_, nullptr)),
+            size_(std::exchange(other.size_, 0)), block_bytes_(std::exchange(other.block_bytes_, 0)) {}
+
+        Buffer& operator=(Buffer&& other) noexcept {
+            std::swap(begin_, other.begin_);
+            std::swap(size_, other.size_);
+            std::swap(block_bytes_, other.block_bytes_);
+            return *this;
+        }
+
+        ~Buffer() {
+            if (begin_ != nullptr) {
+                release(begin_, block_bytes_);
+            }
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        T* data() {
+            return begin_;
+        }
+
+        const T* data() const {
+            return begin_;
+        }
+
+        T* begin() {
+            return begin_;
+        }
+
+        T* end() {
+            return begin_ + size_;
+        }
+
+        T& operator[](size_t index) {
+            return begin_[index];
+        }
+
+        const T& operator[](size_t index) const {
+            return begin_[index];
+        }
+    };
+
+};
 
 class BigInteger;
 
+template<size_t Bits>
+class FixedBigInteger;
+
 BigInteger operator + (const BigInteger& n1, const BigInteger& n2);
+BigInteger operator + (BigInteger&& n1, const BigInteger& n2);
+BigInteger operator + (const BigInteger& n1, BigInteger&& n2);
+BigInteger operator + (BigInteger&& n1, BigInteger&& n2);
 BigInteger operator - (const BigInteger& n1, const BigInteger& n2);
+BigInteger operator - (BigInteger&& n1, const BigInteger& n2);
+BigInteger operator - (const BigInteger& n1, BigInteger&& n2);
+BigInteger operator - (BigInteger&& n1, BigInteger&& n2);
+BigInteger operator * (const BigInteger& n1, const BigInteger& n2);
+BigInteger operator * (const BigInteger& n1, int64_t n2);
+BigInteger operator * (BigInteger&& n1, int64_t n2);
+BigInteger operator * (int64_t n1, const BigInteger& n2);
+BigInteger operator * (int64_t n1, BigInteger&& n2);
+BigInteger operator / (const BigInteger& n1, const BigInteger& n2);
+BigInteger operator / (const BigInteger& n1, int64_t n2);
+BigInteger operator % (const BigInteger& n1, int64_t n2);
+BigInteger operator << (BigInteger num, size_t bits);
+BigInteger operator >> (BigInteger num, size_t bits);
+BigInteger operator & (BigInteger n1, const BigInteger& n2);
+BigInteger operator | (BigInteger n1, const BigInteger& n2);
+BigInteger operator ^ (BigInteger n1, const BigInteger& n2);
+std::pair<BigInteger, BigInteger> divmod(const BigInteger& n1, const BigInteger& n2);
+std::pair<BigInteger, int64_t> divmod(const BigInteger& n1, int64_t n2);
+BigInteger gcd(const BigInteger& n1, const BigInteger& n2);
+std::pair<BigInteger, BigInteger> iroot_rem(const BigInteger& n, size_t k);
+bool is_perfect_power(const BigInteger& n, BigInteger& root, size_t& exponent);
+std::to_chars_result to_chars(char* first, char* last, const BigInteger& value);
+std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value);
+
+class BigIntegerView;
+
+// like std::from_chars_result for the binary form
+struct from_bytes_result {
+    const std::byte* ptr;
+    std::errc ec;
+};
+
+size_t binary_size(const BigInteger& value);
+std::byte* to_bytes(std::byte* out, const BigInteger& value);
+from_bytes_result from_bytes(std::span<const std::byte> bytes, BigIntegerView& view);
+from_bytes_result from_bytes(std::span<const std::byte> bytes, BigInteger& value);
 
 class BigInteger {
 
-private:
+private:
+
+    using limb = uint64_t;
+    using double_limb = unsigned __int128;
+    using signed_double_limb = __int128;
+
+    // limb array that keeps up to inline_limbs limbs inside the object and spills to the heap beyond that
+    class LimbVector {
+    private:
+        constexpr static const size_t inline_limbs = 2;
+
+        limb* begin_;
+        size_t size_;
+        size_t capacity_;
+        limb inline_storage_[inline_limbs];
+
+        bool is_inline() const {
+            return begin_ == inline_storage_;
+        }
+
+        void release() {
+            if (!is_inline()) {
+                ScratchArena::release(begin_, capacity_ * sizeof(limb));
+            }
+            begin_ = inline_storage_;
+            size_ = 0;
+            capacity_ = inline_limbs;
+        }
+
+        void steal(LimbVector& other) {
+            if (other.is_inline()) {
+                std::copy(other.begin_, other.begin_ + other.size_, inline_storage_);
+            } else {
+                begin_ = other.begin_;
+                capacity_ = other.capacity_;
+                other.begin_ = other.inline_storage_;
+                other.capacity_ = inline_limbs;
+            }
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+
+    public:
+        LimbVector(): begin_(inline_storage_), size_(0), capacity_(inline_limbs) {}
+
+        LimbVector(size_t count, limb value): LimbVector() {
+            assign(count, value);
+        }
+
+        LimbVector(std::initializer_list<limb> list): LimbVector() {
+            assign(list.begin(), list.end());
+        }
+
+        LimbVector(const limb* first, const limb* last): LimbVector() {
+            assign(first, last);
+        }
+
+        LimbVector(const LimbVector& other): LimbVector() {
+            assign(other.begin(), other.end());
+        }
+
+        LimbVector(LimbVector&& other) noexcept: LimbVector() {
+            steal(other);
+        }
+
+        LimbVector& operator=(const LimbVector& other) {
+            if (this != &other) {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        LimbVector& operator=(LimbVector&& other) noexcept {
+            if (this != &other) {
+                release();
+                steal(other);
+            }
+            return *this;
+        }
+
+        LimbVector& operator=(std::initializer_list<limb> list) {
+            assign(list.begin(), list.end());
+            return *this;
+        }
+
+        ~LimbVector() {
+            release();
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        limb* data() {
+            return begin_;
+        }
+
+        const limb* data() const {
+            return begin_;
+        }
+
+        limb* begin() {
+            return begin_;
+        }
+
+        const limb* begin() const {
+            return begin_;
+        }
+
+        limb* end() {
+            return begin_ + size_;
+        }
+
+        const limb* end() const {
+            return begin_ + size_;
+        }
+
+        limb& operator[](size_t index) {
+            return begin_[index];
+        }
+
+        const limb& operator[](size_t index) const {
+            return begin_[index];
+        }
+
+        limb& back() {
+            return begin_[size_ - 1];
+        }
+
+        const limb& back() const {
+            return begin_[size_ - 1];
+        }
+
+        void reserve(size_t capacity) {
+            if (capacity <= capacity_) {
+                return;
+            }
+            size_t block_bytes;
+            limb* new_begin = static_cast<limb*>(ScratchArena::allocate(std::max(capacity, 2 * capacity_) * sizeof(limb), block_bytes));
+            std::copy(begin_, begin_ + size_, new_begin);
+            size_t size = size_;
+            release();
+            begin_ = new_begin;
+            size_ = size;
+            capacity_ = block_bytes / sizeof(limb);
+        }
+
+        void resize(size_t size, limb value = 0) {
+            reserve(size);
+            if (size > size_) {
+                std::fill(begin_ + size_, begin_ + size, value);
+            }
+            size_ = size;
+        }
+
+        void assign(size_t count, limb value) {
+            size_ = 0;
+            resize(count, value);
+        }
+
+        // the source range may lie inside this vector
+        void assign(const limb* first, const limb* last) {
+            size_t count = static_cast<size_t>(last - first);
+            if (count > capacity_) {
+                size_t block_bytes;
+                limb* new_begin = static_cast<limb*>(ScratchArena::allocate(count * sizeof(limb), block_bytes));
+                std::copy(first, last, new_begin);
+                release();
+                begin_ = new_begin;
+                capacity_ = block_bytes / sizeof(limb);
+            } else if (count > 0) {
+                std::memmove(begin_, first, count * sizeof(limb));
+            }
+            size_ = count;
+        }
+
+        void insert(limb* position, size_t count, limb value) {
+            size_t index = static_cast<size_t>(position - begin_);
+            reserve(size_ + count);
+            std::copy_backward(begin_ + index, begin_ + size_, begin_ + size_ + count);
+            std::fill(begin_ + index, begin_ + index + count, value);
+            size_ += count;
+        }
+
+        void push_back(limb value) {
+            if (size_ == capacity_) {
+                reserve(size_ + 1);
+            }
+            begin_[size_++] = value;
+        }
+
+        void pop_back() {
+            --size_;
+        }
+
+        void clear() {
+            size_ = 0;
+        }
+
+        bool operator==(const LimbVector& other) const {
+            return size_ == other.size_ && std::equal(begin_, begin_ + size_, other.begin_);
+        }
+    };
+
+    bool is_negative = false;
+    LimbVector data;  // little-endian binary limbs, each from 0 to 2^64 - 1
+
+    constexpr static const limb degree_of_10[20] = {
+        1ULL, 10ULL, 100ULL, 1'000ULL, 10'000ULL, 100'000ULL, 1'000'000ULL, 10'000'000ULL,
+        100'000'000ULL, 1'000'000'000ULL, 10'000'000'000ULL, 100'000'000'000ULL,
+        1'000'000'000'000ULL, 10'000'000'000'000ULL, 100'000'000'000'000ULL,
+        1'000'000'000'000'000ULL, 10'000'000'000'000'000ULL, 100'000'000'000'000'000ULL,
+        1'000'000'000'000'000'000ULL, 10'000'000'000'000'000'000ULL
+    };
+    constexpr static const size_t limb_bits = 64;
+    constexpr static const size_t decimal_chunk_size = 19;    // 10^19 is the biggest power of 10 in a limb
+    constexpr static const size_t decimal_conversion_threshold = 40;    // limbs converted by the quadratic loop
+    constexpr static const size_t half_gcd_threshold = 1000;    // limbs below which gcd runs Lehmer's steps only
+    constexpr static const size_t half_gcd_base = 100;    // limbs below which a half-GCD collects Lehmer's steps
+    constexpr static const size_t lehmer_bits = 62;    // leading bits taken by one Lehmer step, cofactors fit in int64_t
+    constexpr static const size_t ntt_piece_bits = 32;    // each limb goes to the NTT as two 32-bit pieces
+    constexpr static const size_t ntt_pieces_per_limb = limb_bits / ntt_piece_bits;
+    constexpr static const limb ntt_piece_mask = (limb(1) << ntt_piece_bits) - 1;
+    // NTT-friendly primes p = c * 2^k + 1 with their primitive roots, their product is above 2^87
+    constexpr static const uint32_t ntt_mod0 = 2'013'265'921;    // 15 * 2^27 + 1
+    constexpr static const uint32_t ntt_mod1 = 469'762'049;    // 7 * 2^26 + 1
+    constexpr static const uint32_t ntt_mod2 = 167'772'161;    // 5 * 2^25 + 1
+    constexpr static const uint32_t ntt_root0 = 31;
+    constexpr static const uint32_t ntt_root1 = 3;
+    constexpr static const uint32_t ntt_root2 = 3;
+    // a coefficient of a 2^24 long product is at most 2^23 * (2^32 - 1)^2 < 2^87, so CRT stays exact
+    constexpr static const size_t max_ntt_deg2 = 24;
+
+    static ThreadPool& thread_pool() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // f(0), ..., f(count - 1) on the shared pool, a plain loop for one thread
+    template<typename F>
+    static void parallel_for(size_t count, size_t threads, F&& f) {
+        thread_pool().parallel_for(count, threads, std::forward<F>(f));
+    }
+
+    static std::vector<uint32_t> build_reversed_bits(size_t len, size_t deg2) {
+        std::vector<uint32_t> reversed_bits(len, 0);
+        for (size_t i = 1; i < len; ++i) {
+            reversed_bits[i] = (reversed_bits[i >> 1] >> 1) | static_cast<uint32_t>((i & 1) << (deg2 - 1));
+        }
+        return reversed_bits;
+    }
+
+    // bit-reversal permutation of each transform length, built once on first use
+    static const std::vector<uint32_t>& reversed_bits_plan(size_t deg2) {
+        static std::once_flag flags[max_ntt_deg2 + 1];
+        static std::vector<uint32_t> plans[max_ntt_deg2 + 1];
+        std::call_once(flags[deg2], [deg2]() {
+            plans[deg2] = build_reversed_bits(size_t(1) << deg2, deg2);
+        });
+        return plans[deg2];
+    }
+
+    template<uint32_t mod>
+    static uint32_t power_mod(uint64_t value, uint64_t pow) {
+        uint64_t result = 1;
+        value %= mod;
+        for (; pow > 0; pow >>= 1) {
+            if (pow & 1) {
+                result = result * value % mod;
+            }
+            value = value * value % mod;
+        }
+        return static_cast<uint32_t>(result);
+    }
+
+    // powers of the stage roots of each transform length, phi_j ^ i is stored at j / 2 + i
+    template<uint32_t mod, uint32_t root>
+    static const std::vector<uint32_t>& roots_plan(size_t deg2) {
+        static std::once_flag flags[max_ntt_deg2 + 1];
+        static std::vector<uint32_t> plans[max_ntt_deg2 + 1];
+        std::call_once(flags[deg2], [deg2]() {
+            size_t len = (size_t(1) << deg2);
+            std::vector<uint32_t>& phi_pow = plans[deg2];
+            phi_pow.assign(std::max(len, size_t(2)), 1);
+            for (size_t j = 2; j <= len; j <<= 1) {
+                uint64_t phi = power_mod<mod>(root, (mod - 1) / j);
+                for (size_t i = 1; i < j / 2; ++i) {
+                    phi_pow[j / 2 + i] = static_cast<uint32_t>(phi_pow[j / 2 + i - 1] * phi % mod);
+                }
+            }
+        });
+        return plans[deg2];
+    }
+
+    // butterflies [first, last) of len / 2 in the stage that joins halves of j-long blocks
+    template<uint32_t mod>
+    static void butterflies(uint32_t* polynom, const uint32_t* roots, size_t j, size_t first, size_t last) {
+        const uint32_t* phi_pow = roots + j / 2;
+        for (size_t k = first; k < last;) {
+            uint32_t* polynom_it1 = polynom + k / (j / 2) * j;
+            uint32_t* polynom_it2 = polynom_it1 + j / 2;
+            size_t i = k % (j / 2);
+            size_t end = std::min(j / 2, i + (last - k));
+            k += end - i;
+            for (; i < end; ++i) {
+                uint32_t mult = static_cast<uint32_t>(uint64_t(phi_pow[i]) * polynom_it2[i] % mod);
+                polynom_it2[i] = (polynom_it1[i] >= mult ? polynom_it1[i] - mult : polynom_it1[i] + mod - mult);
+                polynom_it1[i] = (polynom_it1[i] + mult >= mod ? polynom_it1[i] + mult - mod : polynom_it1[i] + mult);
+            }
+        }
+    }
+
+    // with several threads each one runs the early stages on its own block, the late stages are split by butterflies
+    template<uint32_t mod, uint32_t root>
+    static void number_theoretic_transform(ScratchArena::Buffer<uint32_t>& polynom, size_t deg2, size_t threads) {
+        size_t len = (size_t(1) << deg2);    // polynom array length
+        const std::vector<uint32_t>& reversed_bits = reversed_bits_plan(deg2);    // array of reversed numbers
+        const std::vector<uint32_t>& roots = roots_plan<mod, root>(deg2);    // arrays of phi ^ k for every stage
+        size_t tasks = std::bit_floor(std::min(threads, std::max(len / 2, size_t(1))));
+        size_t block_len = len / tasks;
+
+        parallel_for(tasks, threads, [&](size_t t) {
+            for (size_t i = t * block_len; i < (t + 1) * block_len; ++i) {
+                if (i < reversed_bits[i]) {
+                    std::swap(polynom[i], polynom[reversed_bits[i]]);
+                }
+            }
+        });
+        parallel_for(tasks, threads, [&](size_t t) {
+            for (size_t j = 2; j <= block_len; j <<= 1) {
+                butterflies<mod>(polynom.data() + t * block_len, roots.data(), j, 0, block_len / 2);
+            }
+        });
+        for (size_t j = 2 * block_len; j <= len; j <<= 1) {
+            parallel_for(tasks, threads, [&](size_t t) {
+                butterflies<mod>(polynom.data(), roots.data(), j, t * block_len / 2, (t + 1) * block_len / 2);
+            });
+        }
+    }
+
+    static ScratchArena::Buffer<uint32_t> build_polynom(const LimbVector& limbs, size_t poly_size, uint32_t mod, size_t threads) {
+        ScratchArena::Buffer<uint32_t> poly(poly_size, 0);
+        size_t tasks = std::min(threads, limbs.size());
+        parallel_for(tasks, threads, [&](size_t t) {
+            size_t first = limbs.size() * t / tasks * ntt_pieces_per_limb;
+            size_t last = limbs.size() * (t + 1) / tasks * ntt_pieces_per_limb;
+            for (size_t i = first; i < last; ++i) {
+                poly[i] = static_cast<uint32_t>(((limbs[i / ntt_pieces_per_limb] >> (i % ntt_pieces_per_limb * ntt_piece_bits)) & ntt_piece_mask) % mod);
+            }
+        });
+        return poly;
+    }
+
+    // cyclic convolution of p1 and p2 modulo mod, the result is left in p1
+    template<uint32_t mod, uint32_t root>
+    static void polynom_multiplication(ScratchArena::Buffer<uint32_t>& p1, ScratchArena::Buffer<uint32_t>& p2, size_t deg2, size_t threads) {
+        size_t len = (size_t(1) << deg2);
+        number_theoretic_transform<mod, root>(p1, deg2, threads);
+        number_theoretic_transform<mod, root>(p2, deg2, threads);
+        uint64_t len_inverse = power_mod<mod>(len, mod - 2);
+        size_t tasks = std::min(threads, len);
+        parallel_for(tasks, threads, [&](size_t t) {
+            for (size_t i = len * t / tasks; i < len * (t + 1) / tasks; ++i) {
+                p1[i] = static_cast<uint32_t>(uint64_t(p1[i]) * p2[i] % mod * len_inverse % mod);
+            }
+        });
+
+        number_theoretic_transform<mod, root>(p1, deg2, threads);
+        std::reverse(p1.begin() + 1, p1.end());
+    }
+
+    template<uint32_t mod, uint32_t root>
+    static ScratchArena::Buffer<uint32_t> polynom_product(const LimbVector& a, const LimbVector& b, size_t deg2, size_t threads) {
+        ScratchArena::Buffer<uint32_t> p1 = build_polynom(a, size_t(1) << deg2, mod, threads);
+        ScratchArena::Buffer<uint32_t> p2 = build_polynom(b, size_t(1) << deg2, mod, threads);
+        polynom_multiplication<mod, root>(p1, p2, deg2, threads);
+        return p1;
+    }
+
+    // restores the exact coefficients from three residues with Garner's CRT and packs them with carries into limbs,
+    // every thread packs its own range of limbs and the carries between the ranges are added afterwards
+    static LimbVector fix_polynom(const ScratchArena::Buffer<uint32_t>& r0, const ScratchArena::Buffer<uint32_t>& r1,
+                                  const ScratchArena::Buffer<uint32_t>& r2, size_t result_size, size_t threads) {
+        const uint64_t mod0_inverse = power_mod<ntt_mod1>(ntt_mod0, ntt_mod1 - 2);
+        const uint64_t mod01_inverse = power_mod<ntt_mod2>(uint64_t(ntt_mod0) * ntt_mod1, ntt_mod2 - 2);
+        const uint64_t mod01 = uint64_t(ntt_mod0) * ntt_mod1;
+        LimbVector result(result_size, 0);
+        size_t tasks = std::min(threads, result_size);
+        std::vector<double_limb> carries(tasks, 0);
+        parallel_for(tasks, threads, [&](size_t t) {
+            double_limb carry = 0;
+            size_t first = result_size * t / tasks * ntt_pieces_per_limb;
+            size_t last = result_size * (t + 1) / tasks * ntt_pieces_per_limb;
+            for (size_t i = first; i < last; ++i) {
+                if (i < r0.size()) {
+                    uint64_t t1 = (r1[i] + ntt_mod1 - r0[i] % ntt_mod1) % ntt_mod1 * mod0_inverse % ntt_mod1;
+                    uint64_t x01 = r0[i] + ntt_mod0 * t1;
+                    uint64_t t2 = (r2[i] + ntt_mod2 - x01 % ntt_mod2) % ntt_mod2 * mod01_inverse % ntt_mod2;
+                    carry += x01 + static_cast<double_limb>(mod01) * t2;
+                }
+                result[i / ntt_pieces_per_limb] |= static_cast<limb>(carry & ntt_piece_mask) << (i % ntt_pieces_per_limb * ntt_piece_bits);
+                carry >>= ntt_piece_bits;
+            }
+            carries[t] = carry;
+        });
+        for (size_t t = 0; t + 1 < tasks; ++t) {
+            if (carries[t] != 0) {
+                add_limbs_shifted(result, {static_cast<limb>(carries[t]), static_cast<limb>(carries[t] >> limb_bits)},
+                                  result_size * (t + 1) / tasks);
+            }
+        }
+        result.resize(result_size);
+        return result;
+    }
+
+    // acc += add * 2^(64 * offset)
+    static void add_limbs_shifted(LimbVector& acc, const LimbVector& add, size_t offset) {
+        if (acc.size() < add.size() + offset) {
+            acc.resize(add.size() + offset, 0);
+        }
+        size_t end = add.size() + offset;
+        limb carry = add_n(acc.data() + offset, acc.data() + offset, add.data(), add.size(), 0);
+        if (add_carry_n(acc.data() + end, acc.data() + end, acc.size() - end, carry) != 0) {
+            acc.push_back(1);
+        }
+    }
+
+    // exact product of magnitudes through three modular NTTs
+    static LimbVector multiply_ntt(const LimbVector& a, const LimbVector& b) {
+        if (a.size() < b.size()) {
+            return multiply_ntt(b, a);
+        }
+        size_t result_size = a.size() + b.size();
+        size_t deg2 = 0;
+        while ((size_t(1) << deg2) < result_size * ntt_pieces_per_limb) {
+            ++deg2;
+        }
+        if (deg2 > max_ntt_deg2) {
+            // too long for one transform, split the longer operand and add up the partial products
+            size_t half_size = a.size() / 2;
+            LimbVector low(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(half_size));
+            LimbVector high(a.begin() + static_cast<std::ptrdiff_t>(half_size), a.end());
+            LimbVector result = multiply_ntt(low, b);
+            add_limbs_shifted(result, multiply_ntt(high, b), half_size);
+            result.resize(result_size, 0);
+            return result;
+        }
+        const ParallelMultiplication& parallel = parallel_multiplication();
+        size_t threads = (b.size() >= parallel.threshold ? std::max(parallel.threads, size_t(1)) : 1);
+        ScratchArena::Buffer<uint32_t> r0 = polynom_product<ntt_mod0, ntt_root0>(a, b, deg2, threads);
+        ScratchArena::Buffer<uint32_t> r1 = polynom_product<ntt_mod1, ntt_root1>(a, b, deg2, threads);
+        ScratchArena::Buffer<uint32_t> r2 = polynom_product<ntt_mod2, ntt_root2>(a, b, deg2, threads);
+        return fix_polynom(r0, r1, r2, result_size, threads);
+    }
+
+    static LimbVector multiply_schoolbook(const LimbVector& a, const LimbVector& b) {
+        LimbVector result(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); ++i) {
+            limb carry = 0;
+            for (size_t j = 0; j < b.size(); ++j) {
+                double_limb product = static_cast<double_limb>(a[i]) * b[j] + result[i + j] + carry;
+                result[i + j] = static_cast<limb>(product);
+                carry = static_cast<limb>(product >> limb_bits);
+            }
+            result[i + b.size()] = carry;
+        }
+        return result;
+    }
+
+    static LimbVector slice_limbs(const LimbVector& limbs, size_t begin, size_t end) {
+        begin = std::min(begin, limbs.size());
+        end = std::min(end, limbs.size());
+        return LimbVector(limbs.begin() + static_cast<std::ptrdiff_t>(begin), limbs.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+
+    // a = a1 * B^m + a0, b = b1 * B^m + b0, a1 * b0 + a0 * b1 = (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1
+    static LimbVector multiply_karatsuba(const LimbVector& a, const LimbVector& b) {
+        size_t m = a.size() / 2;
+        LimbVector a0 = slice_limbs(a, 0, m);
+        LimbVector a1 = slice_limbs(a, m, a.size());
+        LimbVector b0 = slice_limbs(b, 0, m);
+        LimbVector b1 = slice_limbs(b, m, b.size());
+        LimbVector z0 = multiply_limbs(a0, b0);
+        LimbVector z2 = multiply_limbs(a1, b1);
+        add_limbs_shifted(a0, a1, 0);
+        add_limbs_shifted(b0, b1, 0);
+        LimbVector z1 = multiply_limbs(a0, b0);
+        subtract_limbs(z1, z0);
+        subtract_limbs(z1, z2);
+
+        LimbVector result(a.size() + b.size(), 0);
+        add_limbs_shifted(result, z0, 0);
+        add_limbs_shifted(result, z1, m);
+        add_limbs_shifted(result, z2, 2 * m);
+        result.resize(a.size() + b.size());
+        return result;
+    }
+
+    static void divide_exact(BigInteger& num, limb divisor) {
+        divide_by_limb(num.data, divisor);
+    }
+
+    // Toom-Cook 3 with evaluation at 0, 1, -1, -2, inf and Bodrato's interpolation sequence
+    static LimbVector multiply_toom3(const LimbVector& a, const LimbVector& b) {
+        size_t k = (a.size() + 2) / 3;
+        BigInteger a0 = from_limbs(slice_limbs(a, 0, k));
+        BigInteger a1 = from_limbs(slice_limbs(a, k, 2 * k));
+        BigInteger a2 = from_limbs(slice_limbs(a, 2 * k, a.size()));
+        BigInteger b0 = from_limbs(slice_limbs(b, 0, k));
+        BigInteger b1 = from_limbs(slice_limbs(b, k, 2 * k));
+        BigInteger b2 = from_limbs(slice_limbs(b, 2 * k, b.size()));
+
+        BigInteger a_sum = a0;
+        a_sum += a2;
+        BigInteger b_sum = b0;
+        b_sum += b2;
+        BigInteger a_minus_one = a_sum;
+        a_minus_one -= a1;
+        BigInteger b_minus_one = b_sum;
+        b_minus_one -= b1;
+        a_sum += a1;
+        b_sum += b1;
+        BigInteger a_minus_two = a2;
+        a_minus_two += a_minus_two;
+        a_minus_two -= a1;
+        a_minus_two += a_minus_two;
+        a_minus_two += a0;
+        BigInteger b_minus_two = b2;
+        b_minus_two += b_minus_two;
+        b_minus_two -= b1;
+        b_minus_two += b_minus_two;
+        b_minus_two += b0;
+
+        BigInteger r0 = a0;
+        r0 *= b0;
+        BigInteger r1 = a_sum;
+        r1 *= b_sum;
+        BigInteger r_minus_one = a_minus_one;
+        r_minus_one *= b_minus_one;
+        BigInteger r_minus_two = a_minus_two;
+        r_minus_two *= b_minus_two;
+        BigInteger r_inf = a2;
+        r_inf *= b2;
+
+        BigInteger r3 = r_minus_two - r1;
+        divide_exact(r3, 3);
+        r1 -= r_minus_one;
+        divide_exact(r1, 2);
+        BigInteger r2 = r_minus_one - r0;
+        r3 = r2 - r3;
+        divide_exact(r3, 2);
+        r3 += r_inf;
+        r3 += r_inf;
+        r2 += r1;
+        r2 -= r_inf;
+        r1 -= r3;
+
+        LimbVector result(a.size() + b.size(), 0);
+        add_limbs_shifted(result, r0.data, 0);
+        add_limbs_shifted(result, r1.data, k);
+        add_limbs_shifted(result, r2.data, 2 * k);
+        add_limbs_shifted(result, r3.data, 3 * k);
+        add_limbs_shifted(result, r_inf.data, 4 * k);
+        result.resize(a.size() + b.size());
+        return result;
+    }
+
+    // a is much longer than b, multiply b by b-sized chunks of a
+    static LimbVector multiply_unbalanced(const LimbVector& a, const LimbVector& b) {
+        LimbVector result(a.size() + b.size(), 0);
+        for (size_t begin = 0; begin < a.size(); begin += b.size()) {
+            add_limbs_shifted(result, multiply_limbs(slice_limbs(a, begin, begin + b.size()), b), begin);
+        }
+        result.resize(a.size() + b.size());
+        return result;
+    }
+
+    // picks the multiplication kernel by the operand sizes
+    static LimbVector multiply_limbs(const LimbVector& a, const LimbVector& b) {
+        if (a.size() < b.size()) {
+            return multiply_limbs(b, a);
+        }
+        const MultiplicationThresholds& thresholds = multiplication_thresholds();
+        if (b.size() < thresholds.karatsuba) {
+            return multiply_schoolbook(a, b);
+        }
+        if (b.size() >= thresholds.ntt) {
+            return multiply_ntt(a, b);
+        }
+        if (a.size() >= 2 * b.size()) {
+            return multiply_unbalanced(a, b);
+        }
+        if (b.size() < thresholds.toom3) {
+            return multiply_karatsuba(a, b);
+        }
+        return multiply_toom3(a, b);
+    }
+
+    void clean_trailing_zeros() {
+        while(data.size() > 1 && data.back() == 0) {
+            data.pop_back();
+        }
+    }
+
+    bool is_zero() const {
+        return (data.size() == 1 && data[0] == 0);
+    }
+
+    static BigInteger from_limbs(LimbVector limbs, bool negative = false) {
+        BigInteger result;
+        result.data = std::move(limbs);
+        result.clean_trailing_zeros();
+        if (result.data.empty()) {
+            result.data = {0};
+        }
+        result.is_negative = (negative && !result.is_zero());
+        return result;
+    }
+
+    static BigInteger from_int64(int64_t value) {
+        return from_limbs({value < 0 ? limb(0) - static_cast<limb>(value) : static_cast<limb>(value)}, value < 0);
+    }
+
+    static void trim_limbs(LimbVector& limbs) {
+        while (limbs.size() > 1 && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+        if (limbs.empty()) {
+            limbs.push_back(0);
+        }
+    }
+
+    // copies count limbs to little-endian bytes
+    static void store_limbs(std::byte* out, const limb* limbs, size_t count) {
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(out, limbs, count * sizeof(limb));
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                limb value = __builtin_bswap64(limbs[i]);
+                std::memcpy(out + i * sizeof(limb), &value, sizeof(limb));
+            }
+        }
+    }
+
+    // copies count limbs from little-endian bytes, which need not be aligned
+    static void load_limbs(limb* limbs, const std::byte* in, size_t count) {
+        std::memcpy(limbs, in, count * sizeof(limb));
+        if constexpr (std::endian::native != std::endian::little) {
+            for (size_t i = 0; i < count; ++i) {
+                limbs[i] = __builtin_bswap64(limbs[i]);
+            }
+        }
+    }
+
+    // out = a + b + carry over n limbs, returns the carry out, out may be a or b
+    static limb add_n_scalar(limb* out, const limb* a, const limb* b, size_t n, limb carry) {
+        for (size_t i = 0; i < n; ++i) {
+            double_limb sum = static_cast<double_limb>(a[i]) + b[i] + carry;
+            out[i] = static_cast<limb>(sum);
+            carry = static_cast<limb>(sum >> limb_bits);
+        }
+        return carry;
+    }
+
+    // out = a - b - borrow over n limbs, returns the borrow out, out may be a or b
+    static limb subtract_n_scalar(limb* out, const limb* a, const limb* b, size_t n, limb borrow) {
+        for (size_t i = 0; i < n; ++i) {
+            double_limb difference = static_cast<double_limb>(a[i]) - b[i] - borrow;
+            out[i] = static_cast<limb>(difference);
+            borrow = static_cast<limb>(difference >> limb_bits) & 1;
+        }
+        return borrow;
+    }
+
+    static std::strong_ordering compare_n_scalar(const limb* a, const limb* b, size_t n) {
+        for (size_t i = n - 1; i < n; --i) {
+            if (a[i] != b[i]) {
+                return a[i] <=> b[i];
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+
+#ifdef BIGINTEGER_X86_SIMD
+    // Carries of a vector of lanes come out of one integer addition over the lane masks:
+    // a lane generates a carry when it overflows and propagates one when it is all ones, so with
+    // generate and propagate disjoint, generate + (generate | propagate) + carry_in has the carry
+    // into lane i as bit i of (sum ^ propagate) and the carry out of the vector in the bit above.
+    // Borrows work the same way with lanes that underflow and lanes that are zero.
+
+    __attribute__((target("avx2")))
+    static unsigned lane_mask_avx2(__m256i lanes) {
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(lanes)));
+    }
+
+    // all ones in lane i for bit i of mask
+    __attribute__((target("avx2")))
+    static __m256i mask_lanes_avx2(unsigned mask) {
+        const __m256i bits = _mm256_set_epi64x(8, 4, 2, 1);
+        return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(mask), bits), bits);
+    }
+
+    __attribute__((target("avx2")))
+    static limb add_n_avx2(limb* out, const limb* a, const limb* b, size_t n, limb carry) {
+        const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i sum = _mm256_add_epi64(x, y);
+            unsigned generate = lane_mask_avx2(_mm256_cmpgt_epi64(_mm256_xor_si256(x, sign), _mm256_xor_si256(sum, sign)));
+            unsigned propagate = lane_mask_avx2(_mm256_cmpeq_epi64(sum, ones));
+            unsigned carries = generate + (generate | propagate) + static_cast<unsigned>(carry);
+            sum = _mm256_sub_epi64(sum, mask_lanes_avx2((carries ^ propagate) & 0xF));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), sum);
+            carry = carries >> 4;
+        }
+        return add_n_scalar(out + i, a + i, b + i, n - i, carry);
+    }
+
+    __attribute__((target("avx2")))
+    static limb subtract_n_avx2(limb* out, const limb* a, const limb* b, size_t n, limb borrow) {
+        const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+        const __m256i zeros = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i difference = _mm256_sub_epi64(x, y);
+            unsigned generate = lane_mask_avx2(_mm256_cmpgt_epi64(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign)));
+            unsigned propagate = lane_mask_avx2(_mm256_cmpeq_epi64(difference, zeros));
+            unsigned borrows = generate + (generate | propagate) + static_cast<unsigned>(borrow);
+            difference = _mm256_add_epi64(difference, mask_lanes_avx2((borrows ^ propagate) & 0xF));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), difference);
+            borrow = borrows >> 4;
+        }
+        return subtract_n_scalar(out + i, a + i, b + i, n - i, borrow);
+    }
+
+    __attribute__((target("avx2")))
+    static std::strong_ordering compare_n_avx2(const limb* a, const limb* b, size_t n) {
+        for (; n >= 4; n -= 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + n - 4));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + n - 4));
+            unsigned different = ~lane_mask_avx2(_mm256_cmpeq_epi64(x, y)) & 0xF;
+            if (different != 0) {
+                size_t i = n - 4 + static_cast<size_t>(std::bit_width(different)) - 1;
+                return a[i] <=> b[i];
+            }
+        }
+        return compare_n_scalar(a, b, n);
+    }
+
+    __attribute__((target("sse4.2")))
+    static unsigned lane_mask_sse42(__m128i lanes) {
+        return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(lanes)));
+    }
+
+    __attribute__((target("sse4.2")))
+    static __m128i mask_lanes_sse42(unsigned mask) {
+        const __m128i bits = _mm_set_epi64x(2, 1);
+        return _mm_cmpeq_epi64(_mm_and_si128(_mm_set1_epi64x(mask), bits), bits);
+    }
+
+    __attribute__((target("sse4.2")))
+    static limb add_n_sse42(limb* out, const limb* a, const limb* b, size_t n, limb carry) {
+        const __m128i sign = _mm_set1_epi64x(INT64_MIN);
+        const __m128i ones = _mm_set1_epi64x(-1);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i sum = _mm_add_epi64(x, y);
+            unsigned generate = lane_mask_sse42(_mm_cmpgt_epi64(_mm_xor_si128(x, sign), _mm_xor_si128(sum, sign)));
+            unsigned propagate = lane_mask_sse42(_mm_cmpeq_epi64(sum, ones));
+            unsigned carries = generate + (generate | propagate) + static_cast<unsigned>(carry);
+            sum = _mm_sub_epi64(sum, mask_lanes_sse42((carries ^ propagate) & 0x3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sum);
+            carry = carries >> 2;
+        }
+        return add_n_scalar(out + i, a + i, b + i, n - i, carry);
+    }
+
+    __attribute__((target("sse4.2")))
+    static limb subtract_n_sse42(limb* out, const limb* a, const limb* b, size_t n, limb borrow) {
+        const __m128i sign = _mm_set1_epi64x(INT64_MIN);
+        const __m128i zeros = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i difference = _mm_sub_epi64(x, y);
+            unsigned generate = lane_mask_sse42(_mm_cmpgt_epi64(_mm_xor_si128(y, sign), _mm_xor_si128(x, sign)));
+            unsigned propagate = lane_mask_sse42(_mm_cmpeq_epi64(difference, zeros));
+            unsigned borrows = generate + (generate | propagate) + static_cast<unsigned>(borrow);
+            difference = _mm_add_epi64(difference, mask_lanes_sse42((borrows ^ propagate) & 0x3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), difference);
+            borrow = borrows >> 2;
+        }
+        return subtract_n_scalar(out + i, a + i, b + i, n - i, borrow);
+    }
+
+    __attribute__((target("sse4.2")))
+    static std::strong_ordering compare_n_sse42(const limb* a, const limb* b, size_t n) {
+        for (; n >= 2; n -= 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + n - 2));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + n - 2));
+            unsigned different = ~lane_mask_sse42(_mm_cmpeq_epi64(x, y)) & 0x3;
+            if (different != 0) {
+                size_t i = n - 2 + static_cast<size_t>(std::bit_width(different)) - 1;
+                return a[i] <=> b[i];
+            }
+        }
+        return compare_n_scalar(a, b, n);
+    }
+#endif
+
+    static limb add_n(limb* out, const limb* a, const limb* b, size_t n, limb carry) {
+#ifdef BIGINTEGER_X86_SIMD
+        switch (simd_kernels()) {
+            case SimdKernels::avx2:
+                return add_n_avx2(out, a, b, n, carry);
+            case SimdKernels::sse42:
+                return add_n_sse42(out, a, b, n, carry);
+            default:
+                break;
+        }
+#endif
+        return add_n_scalar(out, a, b, n, carry);
+    }
+
+    static limb subtract_n(limb* out, const limb* a, const limb* b, size_t n, limb borrow) {
+#ifdef BIGINTEGER_X86_SIMD
+        switch (simd_kernels()) {
+            case SimdKernels::avx2:
+                return subtract_n_avx2(out, a, b, n, borrow);
+            case SimdKernels::sse42:
+                return subtract_n_sse42(out, a, b, n, borrow);
+            default:
+                break;
+        }
+#endif
+        return subtract_n_scalar(out, a, b, n, borrow);
+    }
+
+    static std::strong_ordering compare_n(const limb* a, const limb* b, size_t n) {
+#ifdef BIGINTEGER_X86_SIMD
+        switch (simd_kernels()) {
+            case SimdKernels::avx2:
+                return compare_n_avx2(a, b, n);
+            case SimdKernels::sse42:
+                return compare_n_sse42(a, b, n);
+            default:
+                break;
+        }
+#endif
+        return compare_n_scalar(a, b, n);
+    }
+
+    // out = a + carry over n limbs for a carry of 0 or 1, returns the carry out, out may be a
+    static limb add_carry_n(limb* out, const limb* a, size_t n, limb carry) {
+        size_t i = 0;
+        for (; i < n && carry != 0; ++i) {
+            out[i] = a[i] + 1;
+            carry = static_cast<limb>(out[i] == 0);
+        }
+        if (out != a) {
+            std::copy(a + i, a + n, out + i);
+        }
+        return carry;
+    }
+
+    // out = a - borrow over n limbs for a borrow of 0 or 1, returns the borrow out, out may be a
+    static limb subtract_borrow_n(limb* out, const limb* a, size_t n, limb borrow) {
+        size_t i = 0;
+        for (; i < n && borrow != 0; ++i) {
+            borrow = static_cast<limb>(a[i] == 0);
+            out[i] = a[i] - 1;
+        }
+        if (out != a) {
+            std::copy(a + i, a + n, out + i);
+        }
+        return borrow;
+    }
+
+    // compares magnitudes, high zero limbs are allowed in both arguments
+    static std::strong_ordering compare_limbs(const LimbVector& a, const LimbVector& b) {
+        size_t a_size = a.size();
+        size_t b_size = b.size();
+        while (a_size > 0 && a[a_size - 1] == 0) {
+            --a_size;
+        }
+        while (b_size > 0 && b[b_size - 1] == 0) {
+            --b_size;
+        }
+        if (a_size != b_size) {
+            return a_size <=> b_size;
+        }
+        return compare_n(a.data(), b.data(), a_size);
+    }
+
+    // minuend -= subtrahend, minuend must not be less than subtrahend
+    static void subtract_limbs(LimbVector& minuend, const LimbVector& subtrahend) {
+        size_t n = std::min(minuend.size(), subtrahend.size());
+        limb borrow = subtract_n(minuend.data(), minuend.data(), subtrahend.data(), n, 0);
+        subtract_borrow_n(minuend.data() + n, minuend.data() + n, minuend.size() - n, borrow);
+    }
+
+    // limbs = limbs * mul + add
+    static void multiply_by_limb(LimbVector& limbs, limb mul, limb add = 0) {
+        limb carry = add;
+        for (limb& value : limbs) {
+            double_limb product = static_cast<double_limb>(value) * mul + carry;
+            value = static_cast<limb>(product);
+            carry = static_cast<limb>(product >> limb_bits);
+        }
+        if (carry != 0) {
+            limbs.push_back(carry);
+        }
+    }
+
+    // floor((beta^2 - 1) / d) - beta for a divisor d with the top bit set
+    static limb limb_reciprocal(limb d) {
+        return static_cast<limb>(~double_limb(0) / d);
+    }
+
+    // Moller-Granlund division of high * beta + low by a normalized d with the reciprocal v, high < d
+    static limb divide_by_reciprocal(limb high, limb low, limb d, limb v, limb& remainder) {
+        double_limb q = static_cast<double_limb>(v) * high + ((static_cast<double_limb>(high + 1) << limb_bits) | low);
+        limb q1 = static_cast<limb>(q >> limb_bits);
+        limb q0 = static_cast<limb>(q);
+        limb r = low - q1 * d;
+        limb mask = limb(0) - static_cast<limb>(r > q0);    // taken about half of the time, so kept branchless
+        q1 += mask;
+        r += mask & d;
+        if (r >= d) [[unlikely]] {
+            ++q1;
+            r -= d;
+        }
+        remainder = r;
+        return q1;
+    }
+
+    // limbs /= divisor, returns the remainder; the divisor is normalized and every step is two multiplications
+    static limb divide_by_limb(LimbVector& limbs, limb divisor) {
+        int shift = std::countl_zero(divisor);
+        limb d = divisor << shift;
+        limb v = limb_reciprocal(d);
+        size_t size = limbs.size();
+        limb rem = (shift == 0 ? 0 : limbs[size - 1] >> (limb_bits - static_cast<size_t>(shift)));
+        for (size_t i = size - 1; i < size; --i) {
+            limb low = limbs[i] << shift;
+            if (shift != 0 && i > 0) {
+                low |= limbs[i - 1] >> (limb_bits - static_cast<size_t>(shift));
+            }
+            limbs[i] = divide_by_reciprocal(rem, low, d, v, rem);
+        }
+        trim_limbs(limbs);
+        return rem >> shift;
+    }
+
+    // trailing zero bits of a non-zero magnitude
+    static size_t trailing_zero_bits(const LimbVector& limbs) {
+        size_t zero_limbs = 0;
+        while (limbs[zero_limbs] == 0) {
+            ++zero_limbs;
+        }
+        return zero_limbs * limb_bits + static_cast<size_t>(std::countr_zero(limbs[zero_limbs]));
+    }
+
+    static size_t bit_length(const LimbVector& limbs) {
+        size_t size = limbs.size();
+        while (size > 0 && limbs[size - 1] == 0) {
+            --size;
+        }
+        if (size == 0) {
+            return 0;
+        }
+        return size * limb_bits - static_cast<size_t>(std::countl_zero(limbs[size - 1]));
+    }
+
+    // limbs * 2^bits, the result has at least min_size limbs
+    static LimbVector shift_limbs_left(const LimbVector& limbs, size_t bits, size_t min_size = 0) {
+        size_t limb_shift = bits / limb_bits;
+        size_t bit_shift = bits % limb_bits;
+        LimbVector result(std::max(limbs.size() + limb_shift + 1, min_size), 0);
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            result[i + limb_shift] |= limbs[i] << bit_shift;
+            if (bit_shift != 0) {
+                result[i + limb_shift + 1] |= limbs[i] >> (limb_bits - bit_shift);
+            }
+        }
+        return result;
+    }
+
+    // limbs / 2^bits
+    static LimbVector shift_limbs_right(const LimbVector& limbs, size_t bits) {
+        size_t limb_shift = bits / limb_bits;
+        size_t bit_shift = bits % limb_bits;
+        if (limb_shift >= limbs.size()) {
+            return {0};
+        }
+        LimbVector result(limbs.size() - limb_shift, 0);
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = limbs[i + limb_shift] >> bit_shift;
+            if (bit_shift != 0 && i + limb_shift + 1 < limbs.size()) {
+                result[i] |= limbs[i + limb_shift + 1] << (limb_bits - bit_shift);
+            }
+        }
+        trim_limbs(result);
+        return result;
+    }
+
+    // limbs * 2^bits in place: whole limbs move with one memmove, the sub-limb part is a single pass
+    static void shift_left_in_place(LimbVector& limbs, size_t bits) {
+        size_t limb_shift = bits / limb_bits;
+        size_t bit_shift = bits % limb_bits;
+        limbs.reserve(limbs.size() + limb_shift + 1);
+        if (bit_shift != 0) {
+            limb carry = limbs.back() >> (limb_bits - bit_shift);
+            for (size_t i = limbs.size() - 1; i > 0; --i) {
+                limbs[i] = (limbs[i] << bit_shift) | (limbs[i - 1] >> (limb_bits - bit_shift));
+            }
+            limbs[0] <<= bit_shift;
+            if (carry != 0) {
+                limbs.push_back(carry);
+            }
+        }
+        if (limb_shift != 0) {
+            limbs.insert(limbs.begin(), limb_shift, 0);
+        }
+    }
+
+    // limbs / 2^bits in place
+    static void shift_right_in_place(LimbVector& limbs, size_t bits) {
+        size_t limb_shift = bits / limb_bits;
+        size_t bit_shift = bits % limb_bits;
+        if (limb_shift >= limbs.size()) {
+            limbs = {0};
+            return;
+        }
+        if (limb_shift != 0) {
+            limbs.assign(limbs.begin() + limb_shift, limbs.end());
+        }
+        if (bit_shift != 0) {
+            for (size_t i = 0; i + 1 < limbs.size(); ++i) {
+                limbs[i] = (limbs[i] >> bit_shift) | (limbs[i + 1] << (limb_bits - bit_shift));
+            }
+            limbs.back() >>= bit_shift;
+        }
+        trim_limbs(limbs);
+    }
+
+    // the value in two's complement over size limbs, size must leave room for the sign bit
+    static LimbVector twos_complement(const BigInteger& value, size_t size) {
+        LimbVector result(size, 0);
+        std::copy(value.data.begin(), value.data.end(), result.begin());
+        if (value.is_negative) {
+            subtract_borrow_n(result.data(), result.data(), size, 1);
+            for (limb& x : result) {
+                x = ~x;
+            }
+        }
+        return result;
+    }
+
+    static BigInteger from_twos_complement(LimbVector limbs) {
+        bool negative = (limbs.back() >> (limb_bits - 1)) != 0;
+        if (negative) {
+            for (limb& x : limbs) {
+                x = ~x;
+            }
+            add_carry_n(limbs.data(), limbs.data(), limbs.size(), 1);
+        }
+        return from_limbs(std::move(limbs), negative);
+    }
+
+    // result = operation(a, b) limb by limb on the infinite two's complement forms, as with built-in integers
+    template<typename Operation>
+    static void bitwise(BigInteger& result, const BigInteger& a, const BigInteger& b, Operation operation) {
+        size_t size = std::max(a.data.size(), b.data.size()) + 1;
+        LimbVector x = twos_complement(a, size);
+        LimbVector y = twos_complement(b, size);
+        for (size_t i = 0; i < size; ++i) {
+            x[i] = operation(x[i], y[i]);
+        }
+        result = from_twos_complement(std::move(x));
+    }
+
+    // 5^exponent by squaring, the last power is kept per thread since callers tend to repeat the exponent
+    static const BigInteger& power_of_five(size_t exponent) {
+        constexpr size_t limb_exponent = 27;    // 5^27 is the biggest power of 5 in a limb
+        constexpr limb limb_power = 7'450'580'596'923'828'125ULL;
+        thread_local size_t cached_exponent = 0;
+        thread_local BigInteger cached_power = 1;
+        if (exponent == cached_exponent) {
+            return cached_power;
+        }
+        limb low_power = 1;
+        for (size_t i = 0; i < exponent % limb_exponent; ++i) {
+            low_power *= 5;
+        }
+        BigInteger result = from_limbs({low_power});
+        BigInteger square = from_limbs({limb_power});
+        for (size_t rest = exponent / limb_exponent; rest != 0; rest >>= 1) {
+            if (rest & 1) {
+                result *= square;
+            }
+            if (rest > 1) {
+                square *= square;
+            }
+        }
+        cached_exponent = exponent;
+        cached_power = std::move(result);
+        return cached_power;
+    }
+
+    // Knuth's Algorithm D, the divisor has at least two limbs without high zeros
+    static void divide_knuth(const LimbVector& dividend, const LimbVector& divisor,
+                             LimbVector& quotient, LimbVector& remainder) {
+        size_t n = divisor.size();
+        size_t m = dividend.size() - n;
+        size_t sigma = static_cast<size_t>(std::countl_zero(divisor.back()));
+        LimbVector v = shift_limbs_left(divisor, sigma);
+        LimbVector u = shift_limbs_left(dividend, sigma, dividend.size() + 1);
+        v.resize(n);
+        u.resize(dividend.size() + 1);
+        quotient.assign(m + 1, 0);
+
+        for (size_t j = m; j <= m; --j) {
+            double_limb numerator = (static_cast<double_limb>(u[j + n]) << limb_bits) | u[j + n - 1];
+            double_limb q_hat = numerator / v[n - 1];
+            double_limb r_hat = numerator % v[n - 1];
+            while (q_hat >> limb_bits != 0 ||
+                   q_hat * v[n - 2] > ((r_hat << limb_bits) | u[j + n - 2])) {
+                --q_hat;
+                r_hat += v[n - 1];
+                if (r_hat >> limb_bits != 0) {
+                    break;
+                }
+            }
+
+            limb carry = 0;
+            limb borrow = 0;
+            for (size_t i = 0; i < n; ++i) {
+                double_limb product = q_hat * v[i] + carry;
+                carry = static_cast<limb>(product >> limb_bits);
+                limb sub = static_cast<limb>(product);
+                limb new_borrow = static_cast<limb>(u[i + j] < sub || u[i + j] - sub < borrow);
+                u[i + j] = u[i + j] - sub - borrow;
+                borrow = new_borrow;
+            }
+            bool is_overdrawn = (u[j + n] < carry || u[j + n] - carry < borrow);
+            u[j + n] = u[j + n] - carry - borrow;
+
+            if (is_overdrawn) {
+                --q_hat;
+                carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    double_limb sum = static_cast<double_limb>(u[i + j]) + v[i] + carry;
+                    u[i + j] = static_cast<limb>(sum);
+                    carry = static_cast<limb>(sum >> limb_bits);
+                }
+                u[j + n] += carry;
+            }
+            quotient[j] = static_cast<limb>(q_hat);
+        }
+        u.resize(n);
+        remainder = shift_limbs_right(u, sigma);
+        trim_limbs(quotient);
+    }
+
+    // num * beta^count where beta = 2^64
+    static BigInteger limb_shifted(const BigInteger& num, size_t count) {
+        if (num.is_zero()) {
+            return num;
+        }
+        BigInteger result = num;
+        result.data.insert(result.data.begin(), count, 0);
+        return result;
+    }
+
+    // Burnikel-Ziegler 2n / 1n step: a < b * beta^n, b has n limbs and its top bit set
+    static void divide_two_by_one(const BigInteger& a, const BigInteger& b, size_t n,
+                                  BigInteger& quotient, BigInteger& remainder) {
+        if (n % 2 == 1 || n < division_thresholds().burnikel_ziegler) {
+            divide_schoolbook(a.data, b.data, quotient.data, remainder.data);
+            quotient.is_negative = false;
+            remainder.is_negative = false;
+            return;
+        }
+        size_t h = n / 2;
+        BigInteger high_quotient;
+        BigInteger high_remainder;
+        divide_three_by_two(from_limbs(slice_limbs(a.data, h, 4 * h)), b, h, high_quotient, high_remainder);
+        BigInteger low_quotient;
+        divide_three_by_two(limb_shifted(high_remainder, h) + from_limbs(slice_limbs(a.data, 0, h)), b, h,
+                            low_quotient, remainder);
+        quotient = limb_shifted(high_quotient, h);
+        quotient += low_quotient;
+    }
+
+    // Burnikel-Ziegler 3h / 2h step: a = [a1 a2 a3], b = [b1 b2] in h-limb blocks, a < b * beta^h
+    static void divide_three_by_two(const BigInteger& a, const BigInteger& b, size_t h,
+                                    BigInteger& quotient, BigInteger& remainder) {
+        BigInteger a12 = from_limbs(slice_limbs(a.data, h, a.data.size()));
+        BigInteger a1 = from_limbs(slice_limbs(a.data, 2 * h, a.data.size()));
+        BigInteger b1 = from_limbs(slice_limbs(b.data, h, 2 * h));
+        BigInteger b2 = from_limbs(slice_limbs(b.data, 0, h));
+        BigInteger r1;
+        if (a1 < b1) {
+            divide_two_by_one(a12, b1, h, quotient, r1);
+        } else {
+            quotient = from_limbs(LimbVector(h, ~limb(0)));
+            r1 = a12 - limb_shifted(b1, h) + b1;
+        }
+        BigInteger d = quotient;
+        d *= b2;
+        remainder = limb_shifted(r1, h) + from_limbs(slice_limbs(a.data, 0, h));
+        remainder -= d;
+        while (remainder < 0) {
+            remainder += b;
+            --quotient;
+        }
+    }
+
+    // schoolbook division in n-limb blocks, step divides a 2n-limb value z < b * beta^n by b
+    template<typename Step>
+    static void divide_by_blocks(const LimbVector& dividend, const LimbVector& divisor, size_t n,
+                                 Step step, LimbVector& quotient, LimbVector& remainder) {
+        size_t sigma = n * limb_bits - bit_length(divisor);
+        BigInteger b = from_limbs(shift_limbs_left(divisor, sigma));
+        LimbVector a = shift_limbs_left(dividend, sigma);
+        size_t blocks = std::max<size_t>(2, (bit_length(a) + n * limb_bits) / (n * limb_bits));
+        a.resize(blocks * n, 0);
+
+        BigInteger z = from_limbs(slice_limbs(a, (blocks - 2) * n, blocks * n));
+        BigInteger block_quotient;
+        BigInteger block_remainder;
+        quotient.assign((blocks - 1) * n + 1, 0);
+        for (size_t i = blocks - 2; i < blocks; --i) {
+            step(z, b, block_quotient, block_remainder);
+            add_limbs_shifted(quotient, block_quotient.data, i * n);
+            if (i > 0) {
+                z = limb_shifted(block_remainder, n) + from_limbs(slice_limbs(a, (i - 1) * n, i * n));
+            }
+        }
+        trim_limbs(quotient);
+        remainder = shift_limbs_right(block_remainder.data, sigma);
+    }
+
+    static void divide_burnikel_ziegler(const LimbVector& dividend, const LimbVector& divisor,
+                                        LimbVector& quotient, LimbVector& remainder) {
+        // block size j * 2^k, so that halving it k times ends in the Knuth base case
+        size_t m = 1;
+        while (m * division_thresholds().burnikel_ziegler <= divisor.size()) {
+            m <<= 1;
+        }
+        size_t n = (divisor.size() + m - 1) / m * m;
+        divide_by_blocks(dividend, divisor, n, [n](const BigInteger& z, const BigInteger& b, BigInteger& q, BigInteger& r) {
+            divide_two_by_one(z, b, n, q, r);
+        }, quotient, remainder);
+    }
+
+    // floor(beta^(2n) / b) for an n-limb b with the top bit set, by Newton iteration with doubling precision
+    static BigInteger reciprocal(const BigInteger& b) {
+        size_t n = b.data.size();
+        BigInteger power = from_limbs(shift_limbs_left({1}, 2 * n * limb_bits));
+        if (n < division_thresholds().newton) {
+            return power / b;
+        }
+        size_t h = (n + 1) / 2;
+        BigInteger x = limb_shifted(reciprocal(from_limbs(slice_limbs(b.data, n - h, n))), n - h);
+        BigInteger error = power - b * x;
+        BigInteger correction = x * error;
+        correction.data = slice_limbs(correction.data, 2 * n, correction.data.size());
+        x += from_limbs(correction.data, correction.is_negative);
+        BigInteger remainder = power - b * x;
+        while (remainder < 0) {
+            remainder += b;
+            --x;
+        }
+        while (remainder >= b) {
+            remainder -= b;
+            ++x;
+        }
+        return x;
+    }
+
+    static void divide_newton(const LimbVector& dividend, const LimbVector& divisor,
+                              LimbVector& quotient, LimbVector& remainder) {
+        size_t n = divisor.size();
+        BigInteger x = reciprocal(from_limbs(shift_limbs_left(divisor, n * limb_bits - bit_length(divisor))));
+        divide_by_blocks(dividend, divisor, n, [n, &x](const BigInteger& z, const BigInteger& b, BigInteger& q, BigInteger& r) {
+            q = z * x;
+            q.data = slice_limbs(q.data, 2 * n, q.data.size());
+            q = from_limbs(q.data);
+            r = z - q * b;
+            while (r < 0) {
+                r += b;
+                --q;
+            }
+            while (r >= b) {
+                r -= b;
+                ++q;
+            }
+        }, quotient, remainder);
+    }
+
+    static void divide_schoolbook(const LimbVector& dividend, const LimbVector& divisor,
+                                  LimbVector& quotient, LimbVector& remainder) {
+        if (compare_limbs(dividend, divisor) == std::strong_ordering::less) {
+            quotient = {0};
+            remainder = dividend;
+            trim_limbs(remainder);
+        } else if (divisor.size() == 1) {
+            quotient = dividend;
+            remainder = {divide_by_limb(quotient, divisor[0])};
+        } else {
+            divide_knuth(dividend, divisor, quotient, remainder);
+        }
+    }
+
+    // picks the division algorithm by the divisor and quotient sizes
+    static void divide_limbs(const LimbVector& dividend, const LimbVector& divisor,
+                             LimbVector& quotient, LimbVector& remainder) {
+        const DivisionThresholds& thresholds = division_thresholds();
+        if (divisor.size() < thresholds.burnikel_ziegler || dividend.size() < divisor.size() + thresholds.burnikel_ziegler) {
+            divide_schoolbook(dividend, divisor, quotient, remainder);
+        } else if (divisor.size() < thresholds.newton) {
+            divide_burnikel_ziegler(dividend, divisor, quotient, remainder);
+        } else {
+            divide_newton(dividend, divisor, quotient, remainder);
+        }
+    }
+
+    // truncating division, the remainder takes the sign of the dividend
+    static void divide(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder) {
+        bool quotient_negativeness = (dividend.is_negative != divisor.is_negative);
+        bool remainder_negativeness = dividend.is_negative;
+        divide_limbs(dividend.data, divisor.data, quotient.data, remainder.data);
+        quotient.is_negative = (quotient_negativeness && !quotient.is_zero());
+        remainder.is_negative = (remainder_negativeness && !remainder.is_zero());
+    }
+
+    // Stein's binary GCD of two limbs
+    static limb binary_gcd(limb a, limb b) {
+        if (a == 0 || b == 0) {
+            return a | b;
+        }
+        int common_shift = std::countr_zero(a | b);
+        a >>= std::countr_zero(a);
+        while (b != 0) {
+            b >>= std::countr_zero(b);
+            if (a > b) {
+                std::swap(a, b);
+            }
+            b -= a;
+        }
+        return a << common_shift;
+    }
+
+    // bits [shift, shift + 64) of the magnitude
+    static limb top_bits(const LimbVector& limbs, size_t shift) {
+        size_t index = shift / limb_bits;
+        size_t bit_shift = shift % limb_bits;
+        limb result = (index < limbs.size() ? limbs[index] >> bit_shift : 0);
+        if (bit_shift != 0 && index + 1 < limbs.size()) {
+            result |= limbs[index + 1] << (limb_bits - bit_shift);
+        }
+        return result;
+    }
+
+    // the leading width <= 128 bits of a non-zero magnitude as value * 2^exponent, exact when nothing was cut
+    static double_limb leading_bits(const LimbVector& limbs, size_t width, int64_t& exponent, bool& exact) {
+        size_t bits = bit_length(limbs);
+        exponent = static_cast<int64_t>(bits) - static_cast<int64_t>(width);
+        if (bits <= width) {
+            double_limb value = limbs[0];
+            if (limbs.size() > 1) {
+                value |= static_cast<double_limb>(limbs[1]) << limb_bits;
+            }
+            exact = true;
+            return value << (width - bits);
+        }
+        size_t shift = bits - width;
+        double_limb value = top_bits(limbs, shift);
+        if (width > limb_bits) {
+            value |= static_cast<double_limb>(top_bits(limbs, shift + limb_bits)) << limb_bits;
+        }
+        exact = (trailing_zero_bits(limbs) >= shift);
+        return value;
+    }
+
+    // x * 2^exponent rounded to the nearest double, subnormals included; x has 54 to 127 bits
+    // and sticky marks a non-zero tail below it
+    static double round_to_double(double_limb x, int64_t exponent, bool sticky) {
+        limb high = static_cast<limb>(x >> limb_bits);
+        int64_t bits = (high != 0 ? 2 * limb_bits - std::countl_zero(high) : limb_bits - std::countl_zero(static_cast<limb>(x)));
+        int64_t lowest_exponent = std::max<int64_t>(exponent + bits - 53, -1074);
+        if (lowest_exponent > exponent) {
+            int64_t drop = lowest_exponent - exponent;
+            if (drop > bits) {
+                return 0;
+            }
+            bool half = ((x >> (drop - 1)) & 1) != 0;
+            bool rest = sticky || (x & ((static_cast<double_limb>(1) << (drop - 1)) - 1)) != 0;
+            x >>= drop;
+            if (half && (rest || (x & 1) != 0)) {
+                ++x;
+            }
+            exponent = lowest_exponent;
+        }
+        if (exponent > 1024) {
+            return HUGE_VAL;
+        }
+        return std::ldexp(static_cast<double>(static_cast<limb>(x)), static_cast<int>(exponent));
+    }
+
+    // n / d correctly rounded for a positive d. A quotient of the leading 128 and 64 bits brackets the value,
+    // the exact division with a 66-bit quotient runs only when the bracket straddles a rounding boundary.
+    static double quotient_to_double(const BigInteger& n, const BigInteger& d) {
+        if (n.is_zero()) {
+            return 0;
+        }
+        int64_t n_exponent;
+        int64_t d_exponent;
+        bool n_exact;
+        bool d_exact;
+        double_limb high = leading_bits(n.data, 2 * limb_bits, n_exponent, n_exact);
+        double_limb low = leading_bits(d.data, limb_bits, d_exponent, d_exact);
+        double_limb lower = high / (low + (d_exact ? 0 : 1));
+        double_limb upper = high / low + (n_exact && high % low == 0 ? 0 : 1);
+        double result = round_to_double(lower, n_exponent - d_exponent, false);
+        if (result != round_to_double(upper, n_exponent - d_exponent, false)) {
+            int64_t shift = 66 - (static_cast<int64_t>(bit_length(n.data)) - static_cast<int64_t>(bit_length(d.data)));
+            LimbVector dividend = n.data;
+            LimbVector divisor = d.data;
+            if (shift >= 0) {
+                shift_left_in_place(dividend, static_cast<size_t>(shift));
+            } else {
+                shift_left_in_place(divisor, static_cast<size_t>(-shift));
+            }
+            LimbVector quotient;
+            LimbVector remainder;
+            divide_limbs(dividend, divisor, quotient, remainder);
+            double_limb value = quotient[0];
+            if (quotient.size() > 1) {
+                value |= static_cast<double_limb>(quotient[1]) << limb_bits;
+            }
+            bool sticky = (remainder.size() > 1 || remainder[0] != 0);
+            result = round_to_double(value, -shift, sticky);
+        }
+        return (n.is_negative ? -result : result);
+    }
+
+    // (a, b) -> (m11 * a + m12 * b, m21 * a + m22 * b), the entries of each row have opposite signs
+    struct LehmerMatrix {
+        int64_t m11 = 1;
+        int64_t m12 = 0;
+        int64_t m21 = 0;
+        int64_t m22 = 1;
+    };
+
+    // Lehmer's step for a >= b: the quotients of the leading bits that are certain to match the quotients of a and b
+    static LehmerMatrix lehmer_matrix(const LimbVector& a, const LimbVector& b) {
+        size_t bits = bit_length(a);
+        size_t shift = (bits > lehmer_bits ? bits - lehmer_bits : 0);
+        int64_t x = static_cast<int64_t>(top_bits(a, shift));
+        int64_t y = static_cast<int64_t>(top_bits(b, shift));
+        LehmerMatrix m;
+        while (y + m.m21 > 0 && y + m.m22 > 0) {
+            int64_t q = (x + m.m11) / (y + m.m21);
+            if (q != (x + m.m12) / (y + m.m22)) {
+                break;
+            }
+            int64_t t = m.m11 - q * m.m21;
+            m.m11 = m.m21;
+            m.m21 = t;
+            t = m.m12 - q * m.m22;
+            m.m12 = m.m22;
+            m.m22 = t;
+            t = x - q * y;
+            x = y;
+            y = t;
+        }
+        return m;
+    }
+
+    // applies a Lehmer matrix in one pass, both results are remainders of the Euclidean sequence and so non-negative
+    static void apply_lehmer_matrix(LimbVector& a, LimbVector& b, const LehmerMatrix& m) {
+        b.resize(a.size(), 0);
+        signed_double_limb carry_a = 0;
+        signed_double_limb carry_b = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            signed_double_limb value_a = carry_a + static_cast<signed_double_limb>(m.m11) * a[i] +
+                                         static_cast<signed_double_limb>(m.m12) * b[i];
+            signed_double_limb value_b = carry_b + static_cast<signed_double_limb>(m.m21) * a[i] +
+                                         static_cast<signed_double_limb>(m.m22) * b[i];
+            a[i] = static_cast<limb>(value_a);
+            b[i] = static_cast<limb>(value_b);
+            carry_a = value_a >> limb_bits;
+            carry_b = value_b >> limb_bits;
+        }
+        trim_limbs(a);
+        trim_limbs(b);
+    }
+
+    // u = u * factor for a signed factor
+    static void scale_by_cofactor(BigInteger& u, int64_t factor) {
+        multiply_by_limb(u.data, static_cast<limb>(factor < 0 ? -factor : factor));
+        trim_limbs(u.data);
+        u.is_negative = ((u.is_negative != (factor < 0)) && !u.is_zero());
+    }
+
+    // (u, v) = (m11 * u + m12 * v, m21 * u + m22 * v) for signed u and v, used on the columns of a gcd matrix
+    static void apply_lehmer_matrix(BigInteger& u, BigInteger& v, const LehmerMatrix& m) {
+        BigInteger u_copy = u;
+        BigInteger v_copy = v;
+        scale_by_cofactor(u, m.m11);
+        scale_by_cofactor(v_copy, m.m12);
+        add(u, u, v_copy);
+        scale_by_cofactor(u_copy, m.m21);
+        scale_by_cofactor(v, m.m22);
+        add(v, u_copy, v);
+    }
+
+    // matrix = step * matrix for 2x2 matrices stored by rows
+    static void compose_gcd_matrices(BigInteger* matrix, const BigInteger* step) {
+        BigInteger m11 = step[0] * matrix[0] + step[1] * matrix[2];
+        BigInteger m12 = step[0] * matrix[1] + step[1] * matrix[3];
+        BigInteger m21 = step[2] * matrix[0] + step[3] * matrix[2];
+        BigInteger m22 = step[2] * matrix[1] + step[3] * matrix[3];
+        matrix[0] = std::move(m11);
+        matrix[1] = std::move(m12);
+        matrix[2] = std::move(m21);
+        matrix[3] = std::move(m22);
+    }
+
+    // (a, b) = matrix * (a, b), rows of the matrix are negated and swapped so that a >= b >= 0 still holds
+    static void apply_gcd_matrix(BigInteger* matrix, BigInteger& a, BigInteger& b) {
+        BigInteger new_a = matrix[0] * a + matrix[1] * b;
+        BigInteger new_b = matrix[2] * a + matrix[3] * b;
+        if (new_a.is_negative) {
+            new_a.change_sign();
+            matrix[0].change_sign();
+            matrix[1].change_sign();
+        }
+        if (new_b.is_negative) {
+            new_b.change_sign();
+            matrix[2].change_sign();
+            matrix[3].change_sign();
+        }
+        if (new_a < new_b) {
+            std::swap(new_a, new_b);
+            std::swap(matrix[0], matrix[2]);
+            std::swap(matrix[1], matrix[3]);
+        }
+        a = std::move(new_a);
+        b = std::move(new_b);
+    }
+
+    // one reduction of a >= b > 0 towards b of target limbs that keeps gcd(a, b) and makes a smaller,
+    // the applied transform is composed into matrix unless it is null
+    static void gcd_step(BigInteger& a, BigInteger& b, size_t target, BigInteger* matrix) {
+        size_t size = a.data.size();
+        if (size >= (matrix == nullptr ? half_gcd_threshold : half_gcd_base) && size - b.data.size() <= 1) {
+            // the limbs above offset decide about (size - offset) / 2 limbs of reduction,
+            // so when target is close the offset is taken to reach it in one call
+            size_t offset = size / 2;
+            if (2 * target > size && 4 * (2 * target - size) >= size) {
+                offset = 2 * target - size;
+            }
+            BigInteger step[4] = {1, 0, 0, 1};
+            half_gcd_matrix(a, b, offset, step);
+            size_t bits = bit_length(a.data);
+            apply_gcd_matrix(step, a, b);
+            if (matrix != nullptr) {
+                compose_gcd_matrices(matrix, step);
+            }
+            if (bit_length(a.data) < bits || b.is_zero()) {
+                return;
+            }
+        } else {
+            LehmerMatrix m = lehmer_matrix(a.data, b.data);
+            if (m.m12 != 0) {
+                apply_lehmer_matrix(a.data, b.data, m);
+                if (matrix != nullptr) {
+                    apply_lehmer_matrix(matrix[0], matrix[2], m);
+                    apply_lehmer_matrix(matrix[1], matrix[3], m);
+                }
+                return;
+            }
+        }
+        // no certain quotient in the leading bits, take one Euclidean step
+        BigInteger quotient;
+        BigInteger remainder;
+        divide(a, b, quotient, remainder);
+        a = std::move(b);
+        b = std::move(remainder);
+        if (matrix != nullptr) {
+            // the rows go through the same step: (r1, r2) -> (r2, r1 - quotient * r2)
+            for (size_t j = 0; j < 2; ++j) {
+                std::swap(matrix[j], matrix[j + 2]);
+                matrix[j + 2] -= quotient * matrix[j];
+            }
+        }
+    }
+
+    // half-GCD: reduces the limbs of a >= b above offset until the second one has half of their count,
+    // the collected matrix applied to a and b takes off about a half of that count
+    static void half_gcd_matrix(const BigInteger& a, const BigInteger& b, size_t offset, BigInteger* matrix) {
+        BigInteger x = from_limbs(slice_limbs(a.data, offset, a.data.size()));
+        BigInteger y = from_limbs(slice_limbs(b.data, offset, b.data.size()));
+        size_t target = (x.data.size() + 1) / 2;
+        while (!y.is_zero() && y.data.size() > target) {
+            gcd_step(x, y, target, matrix);
+        }
+    }
+
+    // x^k by squaring
+    static BigInteger power(const BigInteger& x, size_t k) {
+        BigInteger result = 1;
+        BigInteger square = x;
+        for (; k != 0; k >>= 1) {
+            if (k & 1) {
+                result *= square;
+            }
+            if (k > 1) {
+                square *= square;
+            }
+        }
+        return result;
+    }
+
+    // the k-th root of a positive magnitude from its leading limb in floating point
+    static long double root_estimate(const LimbVector& limbs, size_t k) {
+        size_t bits = bit_length(limbs);
+        size_t shift = (bits > limb_bits ? bits - limb_bits : 0);
+        long double leading = static_cast<long double>(top_bits(limbs, shift));
+        return std::exp2((std::log2(leading) + static_cast<long double>(shift)) / static_cast<long double>(k));
+    }
+
+    // ((k - 1) * x + n / x^(k - 1)) / k, by AM-GM never below the floor of the k-th root of n for any x > 0
+    static BigInteger root_newton_step(const BigInteger& n, const BigInteger& x, size_t k) {
+        BigInteger next = n / power(x, k - 1);
+        next += x * static_cast<int64_t>(k - 1);
+        next /= static_cast<int64_t>(k);
+        return next;
+    }
+
+    // floor of the k-th root of n > 0 and n - root^k. A root of at most 64 bits starts from a floating-point
+    // estimate on the leading limb, a longer one from the root of the leading half of its bits, scaled back.
+    // One Newton step brings either to within a few units above the root, the next ones are only for that excess.
+    static std::pair<BigInteger, BigInteger> root_floor(const BigInteger& n, size_t k) {
+        size_t bits = bit_length(n.data);
+        size_t root_bits = (bits + k - 1) / k;
+        BigInteger x;
+        if (root_bits <= limb_bits) {
+            long double estimate = root_estimate(n.data, k);
+            x = from_limbs({estimate >= 0x1p64L - 2 ? ~limb(0) : static_cast<limb>(estimate) + 1});
+        } else {
+            size_t half = root_bits / 2;
+            x = root_floor(n >> (k * half), k).first;
+            ++x;
+            x <<= half;
+        }
+        x = root_newton_step(n, x, k);
+        BigInteger x_power = power(x, k);
+        while (x_power > n) {
+            x = root_newton_step(n, x, k);
+            x_power = power(x, k);
+        }
+        return {std::move(x), n - x_power};
+    }
+
+    // limbs mod divisor without changing them
+    static limb remainder_by_limb(const LimbVector& limbs, limb divisor) {
+        int shift = std::countl_zero(divisor);
+        limb d = divisor << shift;
+        limb v = limb_reciprocal(d);
+        size_t size = limbs.size();
+        limb rem = (shift == 0 ? 0 : limbs[size - 1] >> (limb_bits - static_cast<size_t>(shift)));
+        for (size_t i = size - 1; i < size; --i) {
+            limb low = limbs[i] << shift;
+            if (shift != 0 && i > 0) {
+                low |= limbs[i - 1] >> (limb_bits - static_cast<size_t>(shift));
+            }
+            divide_by_reciprocal(rem, low, d, v, rem);
+        }
+        return rem >> shift;
+    }
+
+    static limb power_mod_limb(limb value, limb pow, limb mod) {
+        limb result = 1 % mod;
+        for (value %= mod; pow != 0; pow >>= 1) {
+            if (pow & 1) {
+                result = static_cast<limb>(static_cast<double_limb>(result) * value % mod);
+            }
+            value = static_cast<limb>(static_cast<double_limb>(value) * value % mod);
+        }
+        return result;
+    }
+
+    // a p-th power is a p-th power residue modulo every prime q = 2jp + 1, which a random number is
+    // with probability 1 / p, so a few such q reject almost every other number in linear time
+    static bool passes_power_residue_test(const LimbVector& limbs, size_t p) {
+        constexpr size_t checked_primes = 4;
+        size_t found = 0;
+        for (limb q = 2 * p + 1; found < checked_primes && q < (limb(1) << 32); q += 2 * p) {
+            bool is_prime = true;
+            for (limb divisor = 3; divisor * divisor <= q && is_prime; divisor += 2) {
+                is_prime = (q % divisor != 0);
+            }
+            if (!is_prime) {
+                continue;
+            }
+            ++found;
+            limb residue = remainder_by_limb(limbs, q);
+            if (residue != 0 && power_mod_limb(residue, (q - 1) / p, q) != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // the p-th root modulo 2^64 of an odd value for an odd p, unique since x^p permutes the odd residues
+    static limb odd_root_modulo_beta(limb value, size_t p) {
+        limb inverse = p;    // p^(-1) mod 2^64 by Newton's iteration, good to 3, 6, 12, ... bits
+        for (size_t i = 0; i < 5; ++i) {
+            inverse *= 2 - p * inverse;
+        }
+        limb result = 1;
+        for (; inverse != 0; inverse >>= 1) {
+            if (inverse & 1) {
+                result *= value;
+            }
+            value *= value;
+        }
+        return result;
+    }
+
+    // whether an odd m > 1 is a p-th power for a prime p, and its root if so. A root of at most 64 bits can only be
+    // the 2-adic root of the lowest limb, which must also match the floating-point estimate; a longer root is taken
+    // only after the power residue test
+    static bool exact_odd_root(const BigInteger& m, size_t p, BigInteger& root) {
+        size_t root_bits = (bit_length(m.data) + p - 1) / p;
+        if (p == 2 && (m.data[0] & 7) != 1) {
+            return false;    // odd squares are 1 modulo 8
+        }
+        if (p != 2 && root_bits <= limb_bits) {
+            limb candidate = odd_root_modulo_beta(m.data[0], p);
+            long double estimate = root_estimate(m.data, p);
+            if (std::abs(static_cast<long double>(candidate) - estimate) > estimate * 0x1p-32L + 2) {
+                return false;
+            }
+            BigInteger candidate_root = from_limbs({candidate});
+            if (power(candidate_root, p) != m) {
+                return false;
+            }
+            root = std::move(candidate_root);
+            return true;
+        }
+        if (!passes_power_residue_test(m.data, p)) {
+            return false;
+        }
+        std::pair<BigInteger, BigInteger> result = root_floor(m, p);
+        if (!result.second.is_zero()) {
+            return false;
+        }
+        root = std::move(result.first);
+        return true;
+    }
+
+    // 10^19, 10^38, 10^76, ... up to the first one whose square has more than size limbs
+    static std::vector<BigInteger> decimal_powers(size_t size) {
+        std::vector<BigInteger> powers = {from_limbs({degree_of_10[decimal_chunk_size]})};
+        while (2 * powers.back().data.size() - 1 <= size) {
+            powers.push_back(powers.back() * powers.back());
+        }
+        return powers;
+    }
+
+    static char* write_chunk(limb chunk, char* out, size_t digits) {
+        for (size_t i = digits; i > 0; --i) {
+            out[i - 1] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+        return out + digits;
+    }
+
+    static size_t chunk_digits(limb chunk) {
+        size_t digits = 1;
+        while (digits < decimal_chunk_size && chunk >= degree_of_10[digits]) {
+            ++digits;
+        }
+        return digits;
+    }
+
+    // quadratic conversion through base 10^19 chunks, zero-padded to width digits when width is not 0
+    static char* write_decimal_chunks(LimbVector value, char* out, size_t width) {
+        LimbVector chunks;
+        do {
+            chunks.push_back(divide_by_limb(value, degree_of_10[decimal_chunk_size]));
+        } while (value.size() > 1 || value[0] != 0);
+        size_t top_digits = chunk_digits(chunks.back());
+        size_t digits = top_digits + decimal_chunk_size * (chunks.size() - 1);
+        if (width > digits) {
+            std::memset(out, '0', width - digits);
+            out += width - digits;
+        }
+        out = write_chunk(chunks.back(), out, top_digits);
+        for (size_t i = chunks.size() - 2; i < chunks.size(); --i) {
+            out = write_chunk(chunks[i], out, decimal_chunk_size);
+        }
+        return out;
+    }
+
+    // divide-and-conquer conversion of value < powers[level]^2,
+    // a padded value is written with exactly 2 * 19 * 2^level digits
+    static char* write_decimal(const LimbVector& value, const std::vector<BigInteger>& powers,
+                               size_t level, char* out, bool padded) {
+        if (value.size() <= decimal_conversion_threshold) {
+            return write_decimal_chunks(value, out, (padded ? decimal_chunk_size << (level + 1) : 0));
+        }
+        LimbVector high;
+        LimbVector low;
+        divide_limbs(value, powers[level].data, high, low);
+        if (!padded && high.size() == 1 && high[0] == 0) {
+            return write_decimal(low, powers, level - 1, out, false);
+        }
+        out = write_decimal(high, powers, level - 1, out, padded);
+        return write_decimal(low, powers, level - 1, out, true);
+    }
+
+    static char* write_decimal(const LimbVector& value, char* out) {
+        if (value.size() <= decimal_conversion_threshold) {
+            return write_decimal_chunks(value, out, 0);
+        }
+        std::vector<BigInteger> powers = decimal_powers(value.size());
+        return write_decimal(value, powers, powers.size() - 1, out, false);
+    }
+
+    // upper bound on the decimal digits of the magnitude
+    size_t decimal_digits_bound() const {
+        constexpr long double log10_2 = 0.30102999566398119521L;
+        return static_cast<size_t>(static_cast<long double>(bit_length(data)) * log10_2) + 2;
+    }
+
+    // quadratic parsing of decimal digits in base 10^19 chunks
+    static LimbVector parse_decimal_chunks(const char* first, size_t length) {
+        LimbVector result = {0};
+        size_t chunk_length = length % decimal_chunk_size;
+        if (chunk_length == 0) {
+            chunk_length = decimal_chunk_size;
+        }
+        for (const char* last = first + length; first != last; first += chunk_length, chunk_length = decimal_chunk_size) {
+            limb chunk = 0;
+            for (size_t i = 0; i < chunk_length; ++i) {
+                chunk = chunk * degree_of_10[1] + static_cast<limb>(first[i] - '0');
+            }
+            multiply_by_limb(result, degree_of_10[chunk_length], chunk);
+        }
+        trim_limbs(result);
+        return result;
+    }
+
+    // divide-and-conquer parsing, the low part takes 19 * 2^level digits
+    static LimbVector parse_decimal(const char* first, size_t length, std::vector<BigInteger>& powers) {
+        if (length <= decimal_chunk_size * decimal_conversion_threshold) {
+            return parse_decimal_chunks(first, length);
+        }
+        size_t level = 0;
+        while ((decimal_chunk_size << (level + 2)) <= length) {
+            ++level;
+        }
+        while (powers.size() <= level) {
+            powers.push_back(powers.back() * powers.back());
+        }
+        size_t low_length = decimal_chunk_size << level;
+        BigInteger result = from_limbs(parse_decimal(first, length - low_length, powers));
+        result *= powers[level];
+        add(result, result, from_limbs(parse_decimal(first + length - low_length, low_length, powers)));
+        return std::move(result.data);
+    }
+
+    // out = |a| + |b|, out may be a or b
+    static void add_magnitudes(LimbVector& out, const LimbVector& a, const LimbVector& b) {
+        const LimbVector& longer = (a.size() >= b.size() ? a : b);
+        const LimbVector& shorter = (a.size() >= b.size() ? b : a);
+        size_t longer_size = longer.size();
+        size_t shorter_size = shorter.size();
+        out.resize(longer_size + 1);    // room for the carry, so the loops never grow the buffer
+        limb carry = add_n(out.data(), longer.data(), shorter.data(), shorter_size, 0);
+        out[longer_size] = add_carry_n(out.data() + shorter_size, longer.data() + shorter_size,
+                                       longer_size - shorter_size, carry);
+        if (out[longer_size] == 0) {
+            out.pop_back();
+        }
+    }
+
+    // out = |a| - |b| for |a| >= |b|, out may be a or b
+    static void subtract_magnitudes(LimbVector& out, const LimbVector& a, const LimbVector& b) {
+        size_t a_size = a.size();
+        size_t b_size = b.size();
+        out.resize(a_size);
+        limb borrow = subtract_n(out.data(), a.data(), b.data(), b_size, 0);
+        subtract_borrow_n(out.data() + b_size, a.data() + b_size, a_size - b_size, borrow);
+        trim_limbs(out);
+    }
+
+    void increment_magnitude() {
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (++data[i] != 0) {
+                return;
+            }
+        }
+        data.push_back(1);
+    }
+
+    // the magnitude must not be zero
+    void decrement_magnitude() {
+        for (size_t i = 0; data[i]-- == 0; ++i) {}
+        clean_trailing_zeros();
+        if (is_zero()) {
+            is_negative = false;
+        }
+    }
+
+public:
+
+    // operand sizes in limbs (of the shorter operand) from which each multiplication kernel takes over,
+    // benchmarks/multiplication_thresholds.cpp measures them for the current machine
+    struct MultiplicationThresholds {
+        size_t karatsuba = 64;
+        size_t toom3 = 400;
+        size_t ntt = 12'000;
+    };
+
+    static MultiplicationThresholds& multiplication_thresholds() {
+        static MultiplicationThresholds thresholds;
+        return thresholds;
+    }
+
+    // divisor sizes in limbs from which Burnikel-Ziegler and Newton division replace Knuth's Algorithm D
+    struct DivisionThresholds {
+        size_t burnikel_ziegler = 60;
+        size_t newton = 2000;
+    };
+
+    static DivisionThresholds& division_thresholds() {
+        static DivisionThresholds thresholds;
+        return thresholds;
+    }
+
+    // NTT products whose shorter operand has at least threshold limbs split their transforms,
+    // pointwise products and carry propagation across threads
+    struct ParallelMultiplication {
+        size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+        size_t threshold = 50'000;
+    };
+
+    static ParallelMultiplication& parallel_multiplication() {
+        static ParallelMultiplication settings;
+        return settings;
+    }
+
+    // vector extensions used by the add, subtract and compare kernels, detected on the first call;
+    // may be lowered (e.g. to compare the kernels) but not raised above the detected level
+    enum class SimdKernels {
+        scalar,
+        sse42,
+        avx2
+    };
+
+    static SimdKernels& simd_kernels() {
+#ifdef BIGINTEGER_X86_SIMD
+        static SimdKernels kernels = (__builtin_cpu_supports("avx2") ? SimdKernels::avx2 :
+                                      __builtin_cpu_supports("sse4.2") ? SimdKernels::sse42 : SimdKernels::scalar);
+#else
+        static SimdKernels kernels = SimdKernels::scalar;
+#endif
+        return kernels;
+    }
+
+    // result = a + b without temporaries, result may be a or b
+    static void add(BigInteger& result, const BigInteger& a, const BigInteger& b, bool negate_b = false) {
+        bool a_negative = a.is_negative;
+        bool b_negative = (b.is_negative != negate_b);
+        if (a_negative == b_negative) {
+            add_magnitudes(result.data, a.data, b.data);
+            result.is_negative = a_negative;
+        } else if (compare_limbs(a.data, b.data) != std::strong_ordering::less) {
+            subtract_magnitudes(result.data, a.data, b.data);
+            result.is_negative = a_negative;
+        } else {
+            subtract_magnitudes(result.data, b.data, a.data);
+            result.is_negative = b_negative;
+        }
+        if (result.is_zero()) {
+            result.is_negative = false;
+        }
+    }
+
+    // result = a - b without temporaries, result may be a or b
+    static void subtract(BigInteger& result, const BigInteger& a, const BigInteger& b) {
+        add(result, a, b, true);
+    }
+
+    // result = a * b, result may be a or b
+    static void multiply(BigInteger& result, const BigInteger& a, const BigInteger& b) {
+        bool negativeness = (a.is_negative != b.is_negative);
+        if (a.is_zero() || b.is_zero()) {
+            result.data = {0};
+            result.is_negative = false;
+            return;
+        }
+        if (a.data.size() == 1 && b.data.size() == 1) {
+            double_limb product = static_cast<double_limb>(a.data[0]) * b.data[0];
+            result.data = {static_cast<limb>(product), static_cast<limb>(product >> limb_bits)};
+        } else {
+            result.data = multiply_limbs(a.data, b.data);
+        }
+        result.clean_trailing_zeros();
+        result.is_negative = negativeness;
+    }
+
+    // result = a * factor in one multiply-accumulate pass, result may be a
+    static void multiply(BigInteger& result, const BigInteger& a, int64_t factor) {
+        bool negativeness = (a.is_negative != (factor < 0));
+        limb magnitude = (factor < 0 ? limb(0) - static_cast<limb>(factor) : static_cast<limb>(factor));
+        if (a.is_zero() || factor == 0) {
+            result.data = {0};
+            result.is_negative = false;
+            return;
+        }
+        result.data = a.data;
+        multiply_by_limb(result.data, magnitude);
+        result.is_negative = negativeness;
+    }
+
+    // quotient = a / divisor truncated, returns the remainder with the sign of a; the divisor must not be zero
+    static int64_t divide(BigInteger& quotient, const BigInteger& a, int64_t divisor) {
+        bool a_negative = a.is_negative;
+        limb magnitude = (divisor < 0 ? limb(0) - static_cast<limb>(divisor) : static_cast<limb>(divisor));
+        quotient.data = a.data;
+        limb remainder = divide_by_limb(quotient.data, magnitude);
+        quotient.is_negative = ((a_negative != (divisor < 0)) && !quotient.is_zero());
+        return (a_negative ? -static_cast<int64_t>(remainder) : static_cast<int64_t>(remainder));
+    }
+
+    BigInteger() {
+        is_negative = false;
+        data = {0};
+    }
+
+    // BigInteger(const BigInteger& other): is_negative(other.is_negative), data(other.data) {}
+
+    BigInteger(int number) {
+        is_negative = (number < 0);
+        long long value = number;
+        data = {static_cast<limb>(is_negative ? -value : value)};
+    }
+
+    BigInteger(const std::string& str): BigInteger() {
+        from_chars(str.data(), str.data() + str.size(), *this);
+    }
+
+    std::strong_ordering operator <=> (const BigInteger& other) const {
+        std::strong_ordering sign_ordering = static_cast<int>(other.is_negative) <=> static_cast<int>(is_negative);
+        if (is_negative != other.is_negative) {
+            return sign_ordering;
+        }
+        /*if (is_negative && !other.is_negative) {
+            return std::strong_ordering::less;
+        }
+        if (!is_negative && other.is_negative) {
+            return std::strong_ordering::greater;
+        }*/
+        if (data.size() != other.data.size()) {
+            bool size_comp_factor = data.size() < other.data.size();
+            return ((size_comp_factor != is_negative) ? std::strong_ordering::less : std::strong_ordering::greater);
+        }
+
+        std::strong_ordering magnitude_ordering = compare_n(data.data(), other.data.data(), data.size());
+        return (is_negative ? 0 <=> magnitude_ordering : magnitude_ordering);
+    }
+
+    bool operator == (const BigInteger& other) const = default;
+        /*{
+        if (data.size() != other.data.size()) {
+            return false;
+        }
+        if (is_negative != other.is_negative) {
+            return false;
+        }
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (data[i] != other.data[i]) {
+                return false;
+            }
+        }
+        return true;
+    }*/
+
+    /*bool operator != (const BigInteger& other) const {
+        return !(*this == other);
+    }*/
+
+    std::string toString() const {
+        std::string res(decimal_digits_bound() + 1, '0');
+        res.resize(static_cast<size_t>(to_chars(res.data(), res.data() + res.size(), *this).ptr - res.data()));
+        return res;
+    }
+
+    friend std::to_chars_result to_chars(char* first, char* last, const BigInteger& value);
+    friend std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value);
+    friend size_t binary_size(const BigInteger& value);
+    friend std::byte* to_bytes(std::byte* out, const BigInteger& value);
+    friend from_bytes_result from_bytes(std::span<const std::byte> bytes, BigIntegerView& view);
+    friend class BigIntegerView;
+
+    void change_sign() {
+        is_negative = (!is_negative && !is_zero());
+    }
+
+    int get_digits_number() const {
+        return static_cast<int>(toString().size() - (is_negative ? 1 : 0));
+    }
+
+    // *this * 10^pow10: one limb multiply for short shifts, otherwise a product with 5^pow10 and a shift by pow10 bits
+    void shift(size_t pow10) {
+        if (is_zero()) {
+            return;
+        }
+        if (pow10 <= decimal_chunk_size) {
+            multiply_by_limb(data, degree_of_10[pow10]);
+            return;
+        }
+        multiply(*this, *this, power_of_five(pow10));
+        shift_left_in_place(data, pow10);
+    }
+
+    /*BigInteger& operator = (const BigInteger& other) {
+        is_negative = other.is_negative;
+        data = other.data;
+        return *this;
+    }*/
+
+    BigInteger operator - () const& {
+        BigInteger num = *this;
+        num.change_sign();
+        return num;
+    }
+
+    BigInteger operator - () && {
+        change_sign();
+        return std::move(*this);
+    }
+
+    BigInteger& operator += (const BigInteger& num) {
+        add(*this, *this, num);
+        return *this;
+    }
+
+    BigInteger& operator -= (const BigInteger& num) {
+        subtract(*this, *this, num);
+        return *this;
+    }
+
+    BigInteger& operator <<= (size_t bits) {
+        if (!is_zero()) {
+            shift_left_in_place(data, bits);
+        }
+        return *this;
+    }
+
+    // rounds towards minus infinity like an arithmetic shift: -x >> k = -(((x - 1) >> k) + 1)
+    BigInteger& operator >>= (size_t bits) {
+        if (!is_negative) {
+            shift_right_in_place(data, bits);
+            return *this;
+        }
+        subtract_borrow_n(data.data(), data.data(), data.size(), 1);
+        shift_right_in_place(data, bits);
+        increment_magnitude();
+        return *this;
+    }
+
+    BigInteger& operator &= (const BigInteger& num) {
+        bitwise(*this, *this, num, [](limb x, limb y) { return x & y; });
+        return *this;
+    }
+
+    BigInteger& operator |= (const BigInteger& num) {
+        bitwise(*this, *this, num, [](limb x, limb y) { return x | y; });
+        return *this;
+    }
+
+    BigInteger& operator ^= (const BigInteger& num) {
+        bitwise(*this, *this, num, [](limb x, limb y) { return x ^ y; });
+        return *this;
+    }
+
+    BigInteger& operator ++ () {
+        if (is_negative) {
+            decrement_magnitude();
+        } else {
+            increment_magnitude();
+        }
+        return *this;
+    }
+
+    BigInteger operator ++ (int) {
+        BigInteger return_value = *this;
+        ++(*this);
+        return return_value;
+    }
+
+    BigInteger& operator -- () {
+        if (is_negative) {
+            increment_magnitude();
+        } else if (is_zero()) {
+            data[0] = 1;
+            is_negative = true;
+        } else {
+            decrement_magnitude();
+        }
+        return *this;
+    }
+
+    BigInteger operator -- (int) {
+        BigInteger return_value = *this;
+        --(*this);
+        return return_value;
+    }
+
+    BigInteger& operator *= (const BigInteger& num) {
+        multiply(*this, *this, num);
+        return *this;
+    }
+
+    BigInteger& operator *= (int64_t factor) {
+        multiply(*this, *this, factor);
+        return *this;
+    }
+
+    BigInteger& operator /= (int64_t divisor) {
+        divide(*this, *this, divisor);
+        return *this;
+    }
+
+    BigInteger& operator %= (int64_t divisor) {
+        *this = from_int64(divide(*this, *this, divisor));
+        return *this;
+    }
+
+    BigInteger& operator /= (const BigInteger& num) {
+        BigInteger quotient;
+        BigInteger remainder;
+        divide(*this, num, quotient, remainder);
+        std::swap(*this, quotient);
+        return *this;
+    }
+
+    BigInteger& operator %= (const BigInteger& num) {
+        BigInteger quotient;
+        BigInteger remainder;
+        divide(*this, num, quotient, remainder);
+        std::swap(*this, remainder);
+        return *this;
+    }
+
+    friend std::pair<BigInteger, BigInteger> divmod(const BigInteger& n1, const BigInteger& n2);
+    friend BigInteger operator % (const BigInteger& n1, int64_t n2);
+    friend BigInteger gcd(const BigInteger& n1, const BigInteger& n2);
+    friend std::pair<BigInteger, BigInteger> iroot_rem(const BigInteger& n, size_t k);
+    friend bool is_perfect_power(const BigInteger& n, BigInteger& root, size_t& exponent);
+    friend class ModularArithmetic;
+    friend class Primality;
+    friend class Rational;
+    friend class BigFloat;
+    friend class ProductTree;
+    friend class BigIntegerColumn;
+    template<size_t Bits>
+    friend class FixedBigInteger;
+
+    explicit operator bool() const {
+        return !is_zero();
+    }
+
+};
+
+BigInteger operator + (const BigInteger& n1, const BigInteger& n2) {
+    BigInteger result;
+    BigInteger::add(result, n1, n2);
+    return result;
+}
+
+BigInteger operator + (BigInteger&& n1, const BigInteger& n2) {
+    BigInteger::add(n1, n1, n2);
+    return std::move(n1);
+}
+
+BigInteger operator + (const BigInteger& n1, BigInteger&& n2) {
+    BigInteger::add(n2, n1, n2);
+    return std::move(n2);
+}
+
+BigInteger operator + (BigInteger&& n1, BigInteger&& n2) {
+    BigInteger::add(n1, n1, n2);
+    return std::move(n1);
+}
+
+BigInteger operator - (const BigInteger& n1, const BigInteger& n2) {
+    BigInteger result;
+    BigInteger::subtract(result, n1, n2);
+    return result;
+}
+
+BigInteger operator - (BigInteger&& n1, const BigInteger& n2) {
+    BigInteger::subtract(n1, n1, n2);
+    return std::move(n1);
+}
+
+BigInteger operator - (const BigInteger& n1, BigInteger&& n2) {
+    BigInteger::subtract(n2, n1, n2);
+    return std::move(n2);
+}
+
+BigInteger operator - (BigInteger&& n1, BigInteger&& n2) {
+    BigInteger::subtract(n1, n1, n2);
+    return std::move(n1);
+}
+
+BigInteger operator * (const BigInteger& n1, const BigInteger& n2) {
+    BigInteger result;
+    BigInteger::multiply(result, n1, n2);
+    return result;
+}
+
+BigInteger operator * (const BigInteger& n1, int64_t n2) {
+    BigInteger result;
+    BigInteger::multiply(result, n1, n2);
+    return result;
+}
+
+BigInteger operator * (BigInteger&& n1, int64_t n2) {
+    BigInteger::multiply(n1, n1, n2);
+    return std::move(n1);
+}
+
+BigInteger operator * (int64_t n1, const BigInteger& n2) {
+    return n2 * n1;
+}
+
+BigInteger operator * (int64_t n1, BigInteger&& n2) {
+    return std::move(n2) * n1;
+}
+
+BigInteger operator / (const BigInteger& n1, int64_t n2) {
+    BigInteger result;
+    BigInteger::divide(result, n1, n2);
+    return result;
+}
+
+BigInteger operator % (const BigInteger& n1, int64_t n2) {
+    BigInteger quotient;
+    return BigInteger::from_int64(BigInteger::divide(quotient, n1, n2));
+}
+
+// quotient and remainder of the truncating short division
+std::pair<BigInteger, int64_t> divmod(const BigInteger& n1, int64_t n2) {
+    std::pair<BigInteger, int64_t> result;
+    result.second = BigInteger::divide(result.first, n1, n2);
+    return result;
+}
+
+BigInteger operator << (BigInteger num, size_t bits) {
+    num <<= bits;
+    return num;
+}
+
+BigInteger operator >> (BigInteger num, size_t bits) {
+    num >>= bits;
+    return num;
+}
+
+BigInteger operator & (BigInteger n1, const BigInteger& n2) {
+    n1 &= n2;
+    return n1;
+}
+
+BigInteger operator | (BigInteger n1, const BigInteger& n2) {
+    n1 |= n2;
+    return n1;
+}
+
+BigInteger operator ^ (BigInteger n1, const BigInteger& n2) {
+    n1 ^= n2;
+    return n1;
+}
+
+BigInteger operator / (const BigInteger& n1, const BigInteger& n2) {
+    return divmod(n1, n2).first;
+}
+
+BigInteger operator % (const BigInteger& n1, const BigInteger& n2) {
+    return divmod(n1, n2).second;
+}
+
+// quotient and remainder of the truncating division in one pass
+std::pair<BigInteger, BigInteger> divmod(const BigInteger& n1, const BigInteger& n2) {
+    std::pair<BigInteger, BigInteger> result;
+    BigInteger::divide(n1, n2, result.first, result.second);
+    return result;
+}
+
+// writes the decimal form into [first, last) without a terminating zero, like std::to_chars
+std::to_chars_result to_chars(char* first, char* last, const BigInteger& value) {
+    size_t bound = value.decimal_digits_bound() + (value.is_negative ? 1 : 0);
+    size_t capacity = static_cast<size_t>(last - first);
+    if (capacity < bound) {
+        std::string buffer(bound, '0');
+        size_t size = static_cast<size_t>(to_chars(buffer.data(), buffer.data() + bound, value).ptr - buffer.data());
+        if (size > capacity) {
+            return {last, std::errc::value_too_large};
+        }
+        std::memcpy(first, buffer.data(), size);
+        return {first + size, std::errc()};
+    }
+    if (value.is_negative) {
+        *first++ = '-';
+    }
+    return {BigInteger::write_decimal(value.data, first), std::errc()};
+}
+
+// parses an optional minus and decimal digits, like std::from_chars
+std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value) {
+    const char* digits_begin = (first != last && *first == '-' ? first + 1 : first);
+    const char* digits_end = digits_begin;
+    while (digits_end != last && '0' <= *digits_end && *digits_end <= '9') {
+        ++digits_end;
+    }
+    if (digits_end == digits_begin) {
+        return {first, std::errc::invalid_argument};
+    }
+    std::vector<BigInteger> powers = {BigInteger::from_limbs({BigInteger::degree_of_10[BigInteger::decimal_chunk_size]})};
+    value.data = BigInteger::parse_decimal(digits_begin, static_cast<size_t>(digits_end - digits_begin), powers);
+    value.is_negative = (digits_begin != first && !value.is_zero());
+    return {digits_end, std::errc()};
+}
+
+// Binary form: a little-endian 64-bit header (limb count << 1 | sign) and the limbs from the lowest one,
+// each as 8 little-endian bytes. Zero has no limbs and the top limb is never zero, so the form is unique.
+
+// A BigInteger read in place from its binary form: the limbs stay in the buffer, which must outlive the view
+class BigIntegerView {
+
+private:
+
+    const std::byte* limbs = nullptr;
+    size_t size = 0;
+    bool negative = false;
+
+public:
+
+    size_t limb_count() const {
+        return size;
+    }
+
+    bool is_negative() const {
+        return negative;
+    }
+
+    // limb i of the magnitude, starting from the lowest
+    uint64_t limb(size_t index) const {
+        uint64_t value;
+        BigInteger::load_limbs(&value, limbs + index * sizeof(uint64_t), 1);
+        return value;
+    }
+
+    explicit operator BigInteger() const {
+        BigInteger result;
+        if (size != 0) {
+            result.data.resize(size);
+            BigInteger::load_limbs(result.data.data(), limbs, size);
+            result.is_negative = negative;
+        }
+        return result;
+    }
+
+    friend from_bytes_result from_bytes(std::span<const std::byte> bytes, BigIntegerView& view);
+
+};
+
+// bytes written by to_bytes
+size_t binary_size(const BigInteger& value) {
+    return (value.is_zero() ? 1 : 1 + value.data.size()) * sizeof(uint64_t);
+}
+
+// writes binary_size(value) bytes and returns the end of them
+std::byte* to_bytes(std::byte* out, const BigInteger& value) {
+    uint64_t size = (value.is_zero() ? 0 : value.data.size());
+    uint64_t header = (size << 1) | static_cast<uint64_t>(value.is_negative);
+    BigInteger::store_limbs(out, &header, 1);
+    BigInteger::store_limbs(out + sizeof(uint64_t), value.data.data(), size);
+    return out + (size + 1) * sizeof(uint64_t);
+}
+
+// reads one value from the front of bytes without copying its limbs, rejects truncated and non-canonical input
+from_bytes_result from_bytes(std::span<const std::byte> bytes, BigIntegerView& view) {
+    if (bytes.size() < sizeof(uint64_t)) {
+        return {bytes.data(), std::errc::invalid_argument};
+    }
+    uint64_t header;
+    BigInteger::load_limbs(&header, bytes.data(), 1);
+    uint64_t size = header >> 1;
+    bool negative = (header & 1) != 0;
+    if (size > bytes.size() / sizeof(uint64_t) - 1) {
+        return {bytes.data(), std::errc::invalid_argument};
+    }
+    BigIntegerView result;
+    result.limbs = bytes.data() + sizeof(uint64_t);
+    result.size = size;
+    result.negative = negative;
+    if ((size == 0 && negative) || (size != 0 && result.limb(size - 1) == 0)) {
+        return {bytes.data(), std::errc::invalid_argument};
+    }
+    view = result;
+    return {result.limbs + size * sizeof(uint64_t), std::errc()};
+}
+
+from_bytes_result from_bytes(std::span<const std::byte> bytes, BigInteger& value) {
+    BigIntegerView view;
+    from_bytes_result result = from_bytes(bytes, view);
+    if (result.ec == std::errc()) {
+        value = static_cast<BigInteger>(view);
+    }
+    return result;
+}
+
+// Unsigned integer of Bits bits, a multiple of 64, with wrap-around arithmetic modulo 2^Bits. The limbs live
+// inside the object and every loop has a trip count known at compile time, so the compiler unrolls the kernels.
+// Everything but the conversions to and from BigInteger is constexpr, for constants and moduli fixed in advance.
+template<size_t Bits>
+class FixedBigInteger {
+
+    static_assert(Bits > 0 && Bits % 64 == 0, "FixedBigInteger takes a positive multiple of 64 bits");
+
+public:
+
+    constexpr static size_t limb_count = Bits / 64;
+
+private:
+
+    using limb = uint64_t;
+    using double_limb = unsigned __int128;
+
+    std::array<limb, limb_count> limbs{};
+
+    template<size_t OtherBits>
+    friend class FixedBigInteger;
+
+    constexpr static size_t significant_limbs(const std::array<limb, limb_count>& value) {
+        size_t size = limb_count;
+        while (size > 0 && value[size - 1] == 0) {
+            --size;
+        }
+        return size;
+    }
+
+    constexpr static int digit_value(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return 16;
+    }
+
+    // the radix of an integer literal and the length of its prefix
+    constexpr static int literal_radix(std::string_view digits, size_t& prefix) {
+        prefix = 0;
+        if (digits.size() > 1 && digits[0] == '0') {
+            if (digits[1] == 'x' || digits[1] == 'X') {
+                prefix = 2;
+                return 16;
+            }
+            if (digits[1] == 'b' || digits[1] == 'B') {
+                prefix = 2;
+                return 2;
+            }
+            prefix = 1;
+            return 8;
+        }
+        return 10;
+    }
+
+    // Knuth's Algorithm D on the fixed arrays, divisor must not be zero
+    constexpr static void divide(const FixedBigInteger& a, const FixedBigInteger& b,
+                                 FixedBigInteger& quotient, FixedBigInteger& remainder) {
+        size_t n = significant_limbs(b.limbs);
+        size_t m = significant_limbs(a.limbs);
+        quotient = FixedBigInteger();
+        if (a < b) {
+            remainder = a;
+            return;
+        }
+        if (n == 1) {
+            double_limb rest = 0;
+            for (size_t i = m - 1; i < m; --i) {
+                double_limb current = (rest << 64) | a.limbs[i];
+                quotient.limbs[i] = static_cast<limb>(current / b.limbs[0]);
+                rest = current % b.limbs[0];
+            }
+            remainder = FixedBigInteger(static_cast<limb>(rest));
+            return;
+        }
+        int shift = std::countl_zero(b.limbs[n - 1]);
+        std::array<limb, limb_count> v{};
+        std::array<limb, limb_count + 1> u{};
+        for (size_t i = n - 1; i > 0; --i) {
+            v[i] = (b.limbs[i] << shift) | (shift != 0 ? b.limbs[i - 1] >> (64 - shift) : 0);
+        }
+        v[0] = b.limbs[0] << shift;
+        u[m] = (shift != 0 ? a.limbs[m - 1] >> (64 - shift) : 0);
+        for (size_t i = m - 1; i > 0; --i) {
+            u[i] = (a.limbs[i] << shift) | (shift != 0 ? a.limbs[i - 1] >> (64 - shift) : 0);
+        }
+        u[0] = a.limbs[0] << shift;
+        for (size_t j = m - n; j <= m - n; --j) {
+            double_limb numerator = (static_cast<double_limb>(u[j + n]) << 64) | u[j + n - 1];
+            double_limb estimate = numerator / v[n - 1];
+            double_limb rest = numerator % v[n - 1];
+            while ((estimate >> 64) != 0 || estimate * v[n - 2] > ((rest << 64) | u[j + n - 2])) {
+                --estimate;
+                rest += v[n - 1];
+                if ((rest >> 64) != 0) {
+                    break;
+                }
+            }
+            limb carry = 0;
+            limb borrow = 0;
+            for (size_t i = 0; i < n; ++i) {
+                double_limb product = estimate * v[i] + carry;
+                carry = static_cast<limb>(product >> 64);
+                limb low = static_cast<limb>(product);
+                limb difference = u[i + j] - low;
+                limb first_borrow = (u[i + j] < low);
+                u[i + j] = difference - borrow;
+                borrow = first_borrow | static_cast<limb>(difference < borrow);
+            }
+            bool is_negative = (u[j + n] < static_cast<double_limb>(carry) + borrow);
+            u[j + n] -= carry + borrow;
+            if (is_negative) {
+                --estimate;
+                limb add_carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    double_limb sum = static_cast<double_limb>(u[i + j]) + v[i] + add_carry;
+                    u[i + j] = static_cast<limb>(sum);
+                    add_carry = static_cast<limb>(sum >> 64);
+                }
+                u[j + n] += add_carry;
+            }
+            quotient.limbs[j] = static_cast<limb>(estimate);
+        }
+        remainder = FixedBigInteger();
+        for (size_t i = 0; i < n; ++i) {
+            remainder.limbs[i] = (u[i] >> shift) | (shift != 0 ? u[i + 1] << (64 - shift) : 0);
+        }
+    }
+
+    constexpr static FixedBigInteger<2 * Bits> wide_product(const FixedBigInteger& a, const FixedBigInteger& b) {
+        FixedBigInteger<2 * Bits> result;
+        for (size_t i = 0; i < limb_count; ++i) {
+            limb carry = 0;
+            for (size_t j = 0; j < limb_count; ++j) {
+                double_limb product = static_cast<double_limb>(a.limbs[i]) * b.limbs[j] + result.limbs[i + j] + carry;
+                result.limbs[i + j] = static_cast<limb>(product);
+                carry = static_cast<limb>(product >> 64);
+            }
+            result.limbs[i + limb_count] = carry;
+        }
+        return result;
+    }
+
+public:
+
+    constexpr FixedBigInteger() = default;
+
+    constexpr FixedBigInteger(uint64_t value) {
+        limbs[0] = value;
+    }
+
+    template<size_t OtherBits> requires (OtherBits < Bits)
+    constexpr FixedBigInteger(const FixedBigInteger<OtherBits>& other) {
+        for (size_t i = 0; i < other.limb_count; ++i) {
+            limbs[i] = other.limbs[i];
+        }
+    }
+
+    // keeps the low Bits bits
+    template<size_t OtherBits> requires (OtherBits > Bits)
+    explicit constexpr FixedBigInteger(const FixedBigInteger<OtherBits>& other) {
+        for (size_t i = 0; i < limb_count; ++i) {
+            limbs[i] = other.limbs[i];
+        }
+    }
+
+    // value modulo 2^Bits, so negative values come out in two's complement
+    explicit FixedBigInteger(const BigInteger& value) {
+        for (size_t i = 0; i < limb_count && i < value.data.size(); ++i) {
+            limbs[i] = value.data[i];
+        }
+        if (value.is_negative) {
+            *this = -*this;
+        }
+    }
+
+    explicit operator BigInteger() const {
+        BigInteger result;
+        result.data.assign(limbs.data(), limbs.data() + limb_count);
+        BigInteger::trim_limbs(result.data);
+        return result;
+    }
+
+    // decimal digits, or hexadecimal after 0x, binary after 0b and octal after 0, with ' separators allowed
+    constexpr static bool is_integer_literal(std::string_view digits) {
+        size_t prefix = 0;
+        int radix = literal_radix(digits, prefix);
+        bool has_digit = (radix == 8);
+        for (size_t i = prefix; i < digits.size(); ++i) {
+            if (digits[i] == '\'') {
+                continue;
+            }
+            if (digit_value(digits[i]) >= radix) {
+                return false;
+            }
+            has_digit = true;
+        }
+        return has_digit;
+    }
+
+    // the value of an integer literal modulo 2^Bits, digits must pass is_integer_literal
+    constexpr static FixedBigInteger parse(std::string_view digits) {
+        size_t prefix = 0;
+        int radix = literal_radix(digits, prefix);
+        FixedBigInteger result;
+        for (size_t i = prefix; i < digits.size(); ++i) {
+            if (digits[i] == '\'') {
+                continue;
+            }
+            limb carry = static_cast<limb>(digit_value(digits[i]));
+            for (size_t j = 0; j < limb_count; ++j) {
+                double_limb product = static_cast<double_limb>(result.limbs[j]) * static_cast<limb>(radix) + carry;
+                result.limbs[j] = static_cast<limb>(product);
+                carry = static_cast<limb>(product >> 64);
+            }
+        }
+        return result;
+    }
+
+    constexpr uint64_t get_limb(size_t index) const {
+        return limbs[index];
+    }
+
+    constexpr size_t bit_length() const {
+        size_t size = significant_limbs(limbs);
+        return (size == 0 ? 0 : size * 64 - static_cast<size_t>(std::countl_zero(limbs[size - 1])));
+    }
+
+    constexpr explicit operator bool() const {
+        return significant_limbs(limbs) != 0;
+    }
+
+    constexpr std::strong_ordering operator <=> (const FixedBigInteger& other) const {
+        for (size_t i = limb_count - 1; i < limb_count; --i) {
+            if (limbs[i] != other.limbs[i]) {
+                return limbs[i] <=> other.limbs[i];
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+
+    constexpr bool operator == (const FixedBigInteger& other) const = default;
+
+    constexpr FixedBigInteger operator ~ () const {
+        FixedBigInteger result;
+        for (size_t i = 0; i < limb_count; ++i) {
+            result.limbs[i] = ~limbs[i];
+        }
+        return result;
+    }
+
+    constexpr FixedBigInteger operator - () const {
+        FixedBigInteger result = ~*this;
+        return result += 1;
+    }
+
+    constexpr FixedBigInteger& operator += (const FixedBigInteger& other) {
+        limb carry = 0;
+        for (size_t i = 0; i < limb_count; ++i) {
+            double_limb sum = static_cast<double_limb>(limbs[i]) + other.limbs[i] + carry;
+            limbs[i] = static_cast<limb>(sum);
+            carry = static_cast<limb>(sum >> 64);
+        }
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator -= (const FixedBigInteger& other) {
+        limb borrow = 0;
+        for (size_t i = 0; i < limb_count; ++i) {
+            double_limb difference = static_cast<double_limb>(limbs[i]) - other.limbs[i] - borrow;
+            limbs[i] = static_cast<limb>(difference);
+            borrow = static_cast<limb>(difference >> 64) & 1;
+        }
+        return *this;
+    }
+
+    // the low half of the schoolbook product, the limbs above Bits are never formed
+    constexpr FixedBigInteger& operator *= (const FixedBigInteger& other) {
+        FixedBigInteger result;
+        for (size_t i = 0; i < limb_count; ++i) {
+            limb carry = 0;
+            for (size_t j = 0; i + j < limb_count; ++j) {
+                double_limb product = static_cast<double_limb>(limbs[i]) * other.limbs[j] + result.limbs[i + j] + carry;
+                result.limbs[i + j] = static_cast<limb>(product);
+                carry = static_cast<limb>(product >> 64);
+            }
+        }
+        return *this = result;
+    }
+
+    // the divisor must not be zero
+    constexpr FixedBigInteger& operator /= (const FixedBigInteger& other) {
+        FixedBigInteger quotient;
+        FixedBigInteger remainder;
+        divide(*this, other, quotient, remainder);
+        return *this = quotient;
+    }
+
+    constexpr FixedBigInteger& operator %= (const FixedBigInteger& other) {
+        FixedBigInteger quotient;
+        FixedBigInteger remainder;
+        divide(*this, other, quotient, remainder);
+        return *this = remainder;
+    }
+
+    constexpr FixedBigInteger& operator <<= (size_t bits) {
+        if (bits >= Bits) {
+            return *this = FixedBigInteger();
+        }
+        size_t limb_shift = bits / 64;
+        size_t bit_shift = bits % 64;
+        for (size_t i = limb_count - 1; i < limb_count; --i) {
+            limb high = (i >= limb_shift ? limbs[i - limb_shift] : 0);
+            limb low = (i >= limb_shift + 1 ? limbs[i - limb_shift - 1] : 0);
+            limbs[i] = (bit_shift == 0 ? high : (high << bit_shift) | (low >> (64 - bit_shift)));
+        }
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator >>= (size_t bits) {
+        if (bits >= Bits) {
+            return *this = FixedBigInteger();
+        }
+        size_t limb_shift = bits / 64;
+        size_t bit_shift = bits % 64;
+        for (size_t i = 0; i < limb_count; ++i) {
+            limb low = (i + limb_shift < limb_count ? limbs[i + limb_shift] : 0);
+            limb high = (i + limb_shift + 1 < limb_count ? limbs[i + limb_shift + 1] : 0);
+            limbs[i] = (bit_shift == 0 ? low : (low >> bit_shift) | (high << (64 - bit_shift)));
+        }
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator &= (const FixedBigInteger& other) {
+        for (size_t i = 0; i < limb_count; ++i) {
+            limbs[i] &= other.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator |= (const FixedBigInteger& other) {
+        for (size_t i = 0; i < limb_count; ++i) {
+            limbs[i] |= other.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator ^= (const FixedBigInteger& other) {
+        for (size_t i = 0; i < limb_count; ++i) {
+            limbs[i] ^= other.limbs[i];
+        }
+        return *this;
+    }
+
+    // the operators are found by argument-dependent lookup, which lets a uint64_t operand convert
+
+    friend constexpr FixedBigInteger operator + (FixedBigInteger a, const FixedBigInteger& b) {
+        return a += b;
+    }
+
+    friend constexpr FixedBigInteger operator - (FixedBigInteger a, const FixedBigInteger& b) {
+        return a -= b;
+    }
+
+    friend constexpr FixedBigInteger operator * (FixedBigInteger a, const FixedBigInteger& b) {
+        return a *= b;
+    }
+
+    friend constexpr FixedBigInteger operator / (FixedBigInteger a, const FixedBigInteger& b) {
+        return a /= b;
+    }
+
+    friend constexpr FixedBigInteger operator % (FixedBigInteger a, const FixedBigInteger& b) {
+        return a %= b;
+    }
+
+    friend constexpr FixedBigInteger operator << (FixedBigInteger a, size_t bits) {
+        return a <<= bits;
+    }
+
+    friend constexpr FixedBigInteger operator >> (FixedBigInteger a, size_t bits) {
+        return a >>= bits;
+    }
+
+    friend constexpr FixedBigInteger operator & (FixedBigInteger a, const FixedBigInteger& b) {
+        return a &= b;
+    }
+
+    friend constexpr FixedBigInteger operator | (FixedBigInteger a, const FixedBigInteger& b) {
+        return a |= b;
+    }
+
+    friend constexpr FixedBigInteger operator ^ (FixedBigInteger a, const FixedBigInteger& b) {
+        return a ^= b;
+    }
+
+    // the full product of 2 * Bits bits
+    friend constexpr FixedBigInteger<2 * Bits> multiply_wide(const FixedBigInteger& a, const FixedBigInteger& b) {
+        return wide_product(a, b);
+    }
+
+    // a * b mod modulus from the full product, the modulus must not be zero
+    friend constexpr FixedBigInteger multiply_mod(const FixedBigInteger& a, const FixedBigInteger& b, const FixedBigInteger& modulus) {
+        return FixedBigInteger(multiply_wide(a, b) % FixedBigInteger<2 * Bits>(modulus));
+    }
+
+    friend constexpr FixedBigInteger power_mod(FixedBigInteger base, const FixedBigInteger& exponent, const FixedBigInteger& modulus) {
+        FixedBigInteger result = FixedBigInteger(1) % modulus;
+        base %= modulus;
+        for (size_t i = exponent.bit_length() - 1; i < Bits; --i) {
+            result = multiply_mod(result, result, modulus);
+            if (((exponent.limbs[i / 64] >> (i % 64)) & 1) != 0) {
+                result = multiply_mod(result, base, modulus);
+            }
+        }
+        return result;
+    }
+
+};
+
+template<char... Chars>
+constexpr char integer_literal_digits[sizeof...(Chars)] = {Chars...};
+
+// an integer literal in the smallest FixedBigInteger that holds it
+template<char... Chars>
+constexpr auto operator ""_fixed() {
+    constexpr std::string_view digits(integer_literal_digits<Chars...>, sizeof...(Chars));
+    static_assert(FixedBigInteger<64>::is_integer_literal(digits), "_fixed takes integer literals");
+    constexpr auto wide = FixedBigInteger<(sizeof...(Chars) * 4 + 63) / 64 * 64>::parse(digits);
+    return FixedBigInteger<std::max<size_t>(64, (wide.bit_length() + 63) / 64 * 64)>(wide);
+}
+
+// the limbs are worked out at compile time, a call only copies them
+template<char... Chars>
+BigInteger operator ""_bi() {
+    constexpr auto value = operator ""_fixed<Chars...>();
+    return static_cast<BigInteger>(value);
+}
+
+std::istream& operator >> (std::istream& input, BigInteger& num) {
+    std::string str;
+    input >> str;
+    num = BigInteger(str);
+    return input;
+}
+
+std::ostream& operator << (std::ostream& output, const BigInteger& num) {
+    output << num.toString();
+    return output;
+}
+
+BigInteger abs(const BigInteger& num) {
+    if (num < 0) {
+        return -num;
+    }
+    return num;
+}
+
+// non-negative greatest common divisor: Lehmer's steps, half-GCD on large inputs and Stein's GCD on the last limb
+BigInteger gcd(const BigInteger& n1, const BigInteger& n2) {
+    BigInteger a = abs(n1);
+    BigInteger b = abs(n2);
+    if (a < b) {
+        std::swap(a, b);
+    }
+    while (!b.is_zero()) {
+        if (b.data.size() == 1) {
+            BigInteger::limb remainder = BigInteger::divide_by_limb(a.data, b.data[0]);
+            return BigInteger::from_limbs({BigInteger::binary_gcd(b.data[0], remainder)});
+        }
+        BigInteger::gcd_step(a, b, 0, nullptr);
+    }
+    return a;
+}
+
+// k-th root truncated towards zero and n - root^k with the sign of n, k > 0; n must not be negative for even k
+std::pair<BigInteger, BigInteger> iroot_rem(const BigInteger& n, size_t k) {
+    if (n.is_zero() || k == 1) {
+        return {n, 0};
+    }
+    std::pair<BigInteger, BigInteger> result = BigInteger::root_floor(abs(n), k);
+    if (n.is_negative) {
+        result.first.change_sign();
+        result.second.change_sign();
+    }
+    return result;
+}
+
+BigInteger iroot(const BigInteger& n, size_t k) {
+    return iroot_rem(n, k).first;
+}
+
+std::pair<BigInteger, BigInteger> isqrt_rem(const BigInteger& n) {
+    return iroot_rem(n, 2);
+}
+
+BigInteger isqrt(const BigInteger& n) {
+    return iroot_rem(n, 2).first;
+}
+
+// whether n = root^exponent for some exponent > 1, with the smallest such root in absolute value.
+// n = 2^v * m with an odd m, every prime exponent p must divide v and is tried on m alone.
+bool is_perfect_power(const BigInteger& n, BigInteger& root, size_t& exponent) {
+    BigInteger odd = abs(n);
+    exponent = 1;
+    if (odd <= 1) {
+        root = n;
+        exponent = (n.is_negative ? 3 : 2);
+        return true;
+    }
+    size_t zero_bits = BigInteger::trailing_zero_bits(odd.data);
+    odd >>= zero_bits;
+    size_t bits = BigInteger::bit_length(odd.data) + zero_bits;
+    std::vector<bool> is_composite(bits + 1, false);
+    for (size_t p = 2; p <= bits; ++p) {
+        if (is_composite[p]) {
+            continue;
+        }
+        for (size_t multiple = p * p; multiple <= bits; multiple += p) {
+            is_composite[multiple] = true;
+        }
+        if (p == 2 && n.is_negative) {
+            continue;
+        }
+        BigInteger odd_root;
+        while (zero_bits % p == 0 && (odd == 1 || BigInteger::exact_odd_root(odd, p, odd_root))) {
+            if (odd != 1) {
+                odd = std::move(odd_root);
+            }
+            exponent *= p;
+            zero_bits /= p;
+            bits = BigInteger::bit_length(odd.data) + zero_bits;
+            if (p > bits) {
+                break;
+            }
+        }
+    }
+    root = odd << zero_bits;
+    if (n.is_negative) {
+        root.change_sign();
+    }
+    return exponent > 1;
+}
+
+bool is_perfect_power(const BigInteger& n) {
+    BigInteger root;
+    size_t exponent;
+    return is_perfect_power(n, root, exponent);
+}
+
+// Many BigIntegers in one allocation: the magnitudes lie back to back in limbs, element i in
+// [offsets[i], offsets[i + 1]) without high zero limbs, so zero takes none. Batch operations split
+// the elements into ranges on the BigInteger thread pool and run the limb kernels of BigInteger on them.
+class BigIntegerColumn {
+
+private:
+
+    using limb = BigInteger::limb;
+    using double_limb = BigInteger::double_limb;
+
+    std::vector<limb> limbs;
+    std::vector<size_t> offsets = {0};
+    std::vector<uint8_t> negative;    // bytes rather than bits, so that tasks may write neighbours
+
+    // f(first, last) over ranges of [0, count), one range per task
+    template<typename F>
+    static void for_ranges(size_t count, const F& f) {
+        const ParallelBatches& parallel = parallel_batches();
+        size_t tasks = (count >= parallel.threshold ? std::min(std::max(parallel.threads, size_t(1)), count) : 1);
+        BigInteger::parallel_for(tasks, tasks, [&](size_t t) {
+            f(count * t / tasks, count * (t + 1) / tasks);
+        });
+    }
+
+    // a column of count elements: write(i, out, negative_result) stores element i into the bound(i) limbs at out
+    // and returns its length, the slack left behind is squeezed out afterwards
+    template<typename Bound, typename Write>
+    static BigIntegerColumn build(size_t count, const Bound& bound, const Write& write) {
+        BigIntegerColumn result;
+        result.offsets.resize(count + 1);
+        for (size_t i = 0; i < count; ++i) {
+            result.offsets[i + 1] = result.offsets[i] + bound(i);
+        }
+        result.limbs.resize(result.offsets[count]);
+        result.negative.assign(count, 0);
+        std::vector<size_t> lengths(count);
+        for_ranges(count, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                bool negative_result = false;
+                lengths[i] = write(i, result.limbs.data() + result.offsets[i], negative_result);
+                result.negative[i] = static_cast<uint8_t>(negative_result && lengths[i] != 0);
+            }
+        });
+        size_t position = 0;
+        for (size_t i = 0; i < count; ++i) {
+            size_t begin = result.offsets[i];
+            if (position != begin && lengths[i] != 0) {
+                std::memmove(result.limbs.data() + position, result.limbs.data() + begin, lengths[i] * sizeof(limb));
+            }
+            result.offsets[i] = position;
+            position += lengths[i];
+        }
+        result.offsets[count] = position;
+        result.limbs.resize(position);
+        return result;
+    }
+
+    const limb* element(size_t index) const {
+        return limbs.data() + offsets[index];
+    }
+
+    // |a| - |b| for |a| >= |b| into out, returns the length without high zero limbs
+    static size_t subtract_into(limb* out, const limb* a, size_t a_size, const limb* b, size_t b_size) {
+        limb borrow = BigInteger::subtract_n(out, a, b, b_size, 0);
+        BigInteger::subtract_borrow_n(out + b_size, a + b_size, a_size - b_size, borrow);
+        while (a_size > 0 && out[a_size - 1] == 0) {
+            --a_size;
+        }
+        return a_size;
+    }
+
+    static std::strong_ordering compare_magnitudes(const limb* a, size_t a_size, const limb* b, size_t b_size) {
+        if (a_size != b_size) {
+            return a_size <=> b_size;
+        }
+        return BigInteger::compare_n(a, b, a_size);
+    }
+
+    static std::strong_ordering compare_values(const limb* a, size_t a_size, bool a_negative,
+                                               const limb* b, size_t b_size, bool b_negative) {
+        if (a_negative != b_negative) {
+            return (a_negative ? std::strong_ordering::less : std::strong_ordering::greater);
+        }
+        std::strong_ordering order = compare_magnitudes(a, a_size, b, b_size);
+        return (a_negative ? 0 <=> order : order);
+    }
+
+    // element-wise a + b, or a - b when subtract is set; the columns must have the same size
+    static BigIntegerColumn add(const BigIntegerColumn& a, const BigIntegerColumn& b, bool subtract) {
+        return build(a.size(), [&](size_t i) {
+            return std::max(a.limb_count(i), b.limb_count(i)) + 1;
+        }, [&](size_t i, limb* out, bool& negative_result) {
+            const limb* x = a.element(i);
+            const limb* y = b.element(i);
+            size_t x_size = a.limb_count(i);
+            size_t y_size = b.limb_count(i);
+            bool x_negative = a.negative[i] != 0;
+            bool y_negative = (b.negative[i] != 0) != subtract;
+            if (x_size < y_size) {
+                std::swap(x, y);
+                std::swap(x_size, y_size);
+                std::swap(x_negative, y_negative);
+            }
+            if (x_negative == y_negative) {
+                limb carry = BigInteger::add_n(out, x, y, y_size, 0);
+                carry = BigInteger::add_carry_n(out + y_size, x + y_size, x_size - y_size, carry);
+                out[x_size] = carry;
+                negative_result = x_negative;
+                return x_size + carry;
+            }
+            if (compare_magnitudes(x, x_size, y, y_size) == std::strong_ordering::less) {
+                negative_result = y_negative;
+                return subtract_into(out, y, y_size, x, x_size);
+            }
+            negative_result = x_negative;
+            return subtract_into(out, x, x_size, y, y_size);
+        });
+    }
+
+    // every element times factor
+    static BigIntegerColumn multiply(const BigIntegerColumn& a, int64_t factor) {
+        limb magnitude = (factor < 0 ? limb(0) - static_cast<limb>(factor) : static_cast<limb>(factor));
+        return build(a.size(), [&a](size_t i) {
+            return a.limb_count(i) + 1;
+        }, [&](size_t i, limb* out, bool& negative_result) {
+            size_t count = a.limb_count(i);
+            if (magnitude == 0 || count == 0) {
+                return size_t(0);
+            }
+            const limb* x = a.element(i);
+            limb carry = 0;
+            for (size_t j = 0; j < count; ++j) {
+                double_limb product = static_cast<double_limb>(x[j]) * magnitude + carry;
+                out[j] = static_cast<limb>(product);
+                carry = static_cast<limb>(product >> BigInteger::limb_bits);
+            }
+            out[count] = carry;
+            negative_result = (a.negative[i] != 0) != (factor < 0);
+            return count + (carry != 0);
+        });
+    }
+
+public:
+
+    // threads for batch operations, and the elements a batch needs before it is split
+    struct ParallelBatches {
+        size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+        size_t threshold = 4096;
+    };
+
+    static ParallelBatches& parallel_batches() {
+        static ParallelBatches settings;
+        return settings;
+    }
+
+    BigIntegerColumn() = default;
+
+    // copies the magnitudes into one block
+    explicit BigIntegerColumn(const std::vector<BigInteger>& values) {
+        *this = build(values.size(), [&values](size_t i) {
+            return (values[i].is_zero() ? 0 : values[i].data.size());
+        }, [&values](size_t i, limb* out, bool& negative_result) {
+            const BigInteger& value = values[i];
+            if (value.is_zero()) {
+                return size_t(0);
+            }
+            std::copy(value.data.begin(), value.data.end(), out);
+            negative_result = value.is_negative;
+            return value.data.size();
+        });
+    }
+
+    size_t size() const {
+        return negative.size();
+    }
+
+    size_t limb_count(size_t index) const {
+        return offsets[index + 1] - offsets[index];
+    }
+
+    bool is_negative(size_t index) const {
+        return negative[index] != 0;
+    }
+
+    void reserve(size_t count, size_t limb_count) {
+        offsets.reserve(count + 1);
+        negative.reserve(count);
+        limbs.reserve(limb_count);
+    }
+
+    void push_back(const BigInteger& value) {
+        if (!value.is_zero()) {
+            limbs.insert(limbs.end(), value.data.begin(), value.data.end());
+        }
+        offsets.push_back(limbs.size());
+        negative.push_back(static_cast<uint8_t>(value.is_negative));
+    }
+
+    // element index into value, whose limb storage is reused when it is big enough
+    void get(size_t index, BigInteger& value) const {
+        size_t count = limb_count(index);
+        if (count == 0) {
+            value.data.assign(1, 0);
+            value.is_negative = false;
+            return;
+        }
+        value.data.assign(element(index), element(index) + count);
+        value.is_negative = is_negative(index);
+    }
+
+    BigInteger operator [] (size_t index) const {
+        BigInteger value;
+        get(index, value);
+        return value;
+    }
+
+    // refills values, reusing the storage of the BigIntegers already there
+    void to_vector(std::vector<BigInteger>& values) const {
+        values.resize(size());
+        for_ranges(size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                get(i, values[i]);
+            }
+        });
+    }
+
+    BigIntegerColumn operator - () const {
+        BigIntegerColumn result = *this;
+        for (size_t i = 0; i < size(); ++i) {
+            result.negative[i] = static_cast<uint8_t>(negative[i] == 0 && limb_count(i) != 0);
+        }
+        return result;
+    }
+
+    friend BigIntegerColumn operator + (const BigIntegerColumn& a, const BigIntegerColumn& b);
+    friend BigIntegerColumn operator - (const BigIntegerColumn& a, const BigIntegerColumn& b);
+    friend BigIntegerColumn operator * (const BigIntegerColumn& a, int64_t factor);
+
+    // element-wise order of *this and other, which must have the same size
+    std::vector<std::strong_ordering> compare(const BigIntegerColumn& other) const {
+        std::vector<std::strong_ordering> result(size(), std::strong_ordering::equal);
+        for_ranges(size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                result[i] = compare_values(element(i), limb_count(i), is_negative(i),
+                                           other.element(i), other.limb_count(i), other.is_negative(i));
+            }
+        });
+        return result;
+    }
+
+    // order of every element and value
+    std::vector<std::strong_ordering> compare(const BigInteger& value) const {
+        size_t value_size = (value.is_zero() ? 0 : value.data.size());
+        std::vector<std::strong_ordering> result(size(), std::strong_ordering::equal);
+        for_ranges(size(), [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                result[i] = compare_values(element(i), limb_count(i), is_negative(i), value.data.data(), value_size, value.is_negative);
+            }
+        });
+        return result;
+    }
+
+    // every task adds the positive and the negative elements of its range into two magnitudes
+    BigInteger sum() const {
+        size_t tasks = (size() >= parallel_batches().threshold ? std::min(std::max(parallel_batches().threads, size_t(1)), size()) : 1);
+        std::vector<BigInteger> partial_sums(tasks);
+        BigInteger::parallel_for(tasks, tasks, [&](size_t t) {
+            BigInteger::LimbVector sums[2] = {{0}, {0}};
+            for (size_t i = size() * t / tasks; i < size() * (t + 1) / tasks; ++i) {
+                BigInteger::LimbVector& acc = sums[negative[i]];
+                size_t count = limb_count(i);
+                if (acc.size() < count) {
+                    acc.resize(count, 0);
+                }
+                limb carry = BigInteger::add_n(acc.data(), acc.data(), element(i), count, 0);
+                if (BigInteger::add_carry_n(acc.data() + count, acc.data() + count, acc.size() - count, carry) != 0) {
+                    acc.push_back(1);
+                }
+            }
+            partial_sums[t] = BigInteger::from_limbs(std::move(sums[0])) - BigInteger::from_limbs(std::move(sums[1]));
+        });
+        BigInteger total = 0;
+        for (const BigInteger& partial_sum : partial_sums) {
+            total += partial_sum;
+        }
+        return total;
+    }
+
+};
+
+BigIntegerColumn operator + (const BigIntegerColumn& a, const BigIntegerColumn& b) {
+    return BigIntegerColumn::add(a, b, false);
+}
+
+BigIntegerColumn operator - (const BigIntegerColumn& a, const BigIntegerColumn& b) {
+    return BigIntegerColumn::add(a, b, true);
+}
+
+BigIntegerColumn operator * (const BigIntegerColumn& a, int64_t factor) {
+    return BigIntegerColumn::multiply(a, factor);
+}
+
+// Arithmetic modulo a fixed modulus. Odd moduli up to montgomery_limit limbs use Montgomery
+// multiplication, the rest use Barrett reduction on top of the fast multiply.
+// Residues are kept in the internal form between operations, scratch buffers are reused across calls.
+class ModularArithmetic {
+
+private:
+
+    using limb = BigInteger::limb;
+    using double_limb = BigInteger::double_limb;
+    using LimbVector = BigInteger::LimbVector;
+
+    constexpr static const size_t montgomery_limit = 48;
+
+    BigInteger modulus;
+    size_t size;    // limbs in the modulus
+    bool is_montgomery;
+    limb inverse = 0;    // -modulus^(-1) mod 2^64
+    BigInteger r_squared;    // beta^(2 * size) mod modulus
+    BigInteger barrett_factor;    // floor(beta^(2 * size) / modulus)
+    BigInteger one;    // 1 in the internal form
+    std::vector<limb> scratch;
+    BigInteger product;
+
+    friend class Primality;
+
+    // CIOS Montgomery product a * b / beta^size mod modulus
+    void montgomery_multiply(const LimbVector& a, const LimbVector& b, BigInteger& result) {
+        const LimbVector& n = modulus.data;
+        std::vector<limb>& t = scratch;
+        t.assign(size + 2, 0);
+        for (size_t i = 0; i < size; ++i) {
+            limb b_i = (i < b.size() ? b[i] : 0);
+            limb carry = 0;
+            size_t j = 0;
+            for (; j < a.size(); ++j) {
+                double_limb current = static_cast<double_limb>(a[j]) * b_i + t[j] + carry;
+                t[j] = static_cast<limb>(current);
+                carry = static_cast<limb>(current >> BigInteger::limb_bits);
+            }
+            for (; carry != 0; ++j) {
+                t[j] += carry;
+                carry = static_cast<limb>(t[j] < carry);
+            }
+
+            limb m = t[0] * inverse;
+            double_limb current = static_cast<double_limb>(m) * n[0] + t[0];
+            carry = static_cast<limb>(current >> BigInteger::limb_bits);
+            for (j = 1; j < size; ++j) {
+                current = static_cast<double_limb>(m) * n[j] + t[j] + carry;
+                t[j - 1] = static_cast<limb>(current);
+                carry = static_cast<limb>(current >> BigInteger::limb_bits);
+            }
+            current = static_cast<double_limb>(t[size]) + carry;
+            t[size - 1] = static_cast<limb>(current);
+            t[size] = t[size + 1] + static_cast<limb>(current >> BigInteger::limb_bits);
+            t[size + 1] = 0;
+        }
+        result.data.assign(t.data(), t.data() + size + 1);
+        BigInteger::trim_limbs(result.data);
+        result.is_negative = false;
+        if (BigInteger::compare_limbs(result.data, n) != std::strong_ordering::less) {
+            BigInteger::subtract_limbs(result.data, n);
+            BigInteger::trim_limbs(result.data);
+        }
+    }
+
+    // value mod modulus for 0 <= value < beta^(2 * size)
+    void barrett_reduce(BigInteger& value) {
+        if (value.data.size() >= size) {
+            BigInteger quotient = BigInteger::from_limbs(BigInteger::slice_limbs(value.data, size - 1, value.data.size()));
+            quotient *= barrett_factor;
+            quotient = BigInteger::from_limbs(BigInteger::slice_limbs(quotient.data, size + 1, quotient.data.size()));
+            quotient *= modulus;
+            value -= quotient;
+        }
+        while (value >= modulus) {
+            value -= modulus;
+        }
+    }
+
+    // result = a * b in the internal form, result must not alias a or b
+    void multiply(const BigInteger& a, const BigInteger& b, BigInteger& result) {
+        if (is_montgomery) {
+            montgomery_multiply(a.data, b.data, result);
+        } else {
+            result = a;
+            result *= b;
+            barrett_reduce(result);
+        }
+    }
+
+    BigInteger to_internal(const BigInteger& value) {
+        BigInteger result = reduce(value);
+        if (is_montgomery) {
+            montgomery_multiply(result.data, r_squared.data, product);
+            std::swap(result, product);
+        }
+        return result;
+    }
+
+    BigInteger from_internal(const BigInteger& value) {
+        if (!is_montgomery) {
+            return value;
+        }
+        BigInteger result;
+        montgomery_multiply(value.data, {1}, result);
+        return result;
+    }
+
+public:
+
+    // the modulus must not be zero, its sign is ignored
+    explicit ModularArithmetic(const BigInteger& mod): modulus(abs(mod)), size(modulus.data.size()) {
+        is_montgomery = (modulus.data[0] % 2 == 1 && size <= montgomery_limit);
+        BigInteger power = BigInteger::from_limbs(BigInteger::shift_limbs_left({1}, 2 * size * BigInteger::limb_bits));
+        if (is_montgomery) {
+            inverse = modulus.data[0];
+            for (size_t i = 0; i < 6; ++i) {
+                inverse *= 2 - modulus.data[0] * inverse;
+            }
+            inverse = -inverse;
+            r_squared = power % modulus;
+        } else {
+            barrett_factor = power / modulus;
+        }
+        one = to_internal(1);
+    }
+
+    const BigInteger& get_modulus() const {
+        return modulus;
+    }
+
+    // value mod modulus in [0, modulus)
+    BigInteger reduce(const BigInteger& value) const {
+        if (!value.is_negative && value < modulus) {
+            return value;
+        }
+        BigInteger result = value % modulus;
+        if (result < 0) {
+            result += modulus;
+        }
+        return result;
+    }
+
+    // a Montgomery product of a * beta^size and b is already a * b in the plain form
+    BigInteger mulmod(const BigInteger& a, const BigInteger& b) {
+        BigInteger result;
+        multiply(to_internal(a), reduce(b), result);
+        return result;
+    }
+
+    // sliding-window exponentiation over odd powers of the base, the exponent must not be negative
+    BigInteger powmod(const BigInteger& base, const BigInteger& exponent) {
+        size_t bits = BigInteger::bit_length(exponent.data);
+        size_t window = (bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 1 ? 2 : 1);
+        auto bit = [&exponent](size_t i) {
+            return (exponent.data[i / BigInteger::limb_bits] >> (i % BigInteger::limb_bits)) & 1;
+        };
+
+        std::vector<BigInteger> odd_powers(size_t(1) << (window - 1));
+        odd_powers[0] = to_internal(base);
+        BigInteger square;
+        multiply(odd_powers[0], odd_powers[0], square);
+        for (size_t i = 1; i < odd_powers.size(); ++i) {
+            multiply(odd_powers[i - 1], square, odd_powers[i]);
+        }
+
+        BigInteger result = one;
+        for (size_t i = bits - 1; i < bits;) {
+            if (bit(i) == 0) {
+                multiply(result, result, product);
+                std::swap(result, product);
+                --i;
+                continue;
+            }
+            size_t low = (i + 1 >= window ? i + 1 - window : 0);
+            while (bit(low) == 0) {
+                ++low;
+            }
+            size_t index = 0;
+            for (size_t j = i; j >= low && j <= i; --j) {
+                index = (index << 1) | bit(j);
+                multiply(result, result, product);
+                std::swap(result, product);
+            }
+            multiply(result, odd_powers[index >> 1], product);
+            std::swap(result, product);
+            i = low - 1;
+        }
+        return from_internal(result);
+    }
+
+};
+
+BigInteger mulmod(const BigInteger& a, const BigInteger& b, const BigInteger& modulus) {
+    return ModularArithmetic(modulus).mulmod(a, b);
+}
+
+BigInteger powmod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus) {
+    return ModularArithmetic(modulus).powmod(base, exponent);
+}
+
+
+// Probable-prime tests: trial division by a sieved table of small primes, then Baillie-PSW, that is a strong test
+// to base 2 and a strong Lucas test, which no known composite passes. Batches and ranges of candidates are tested
+// in parallel on the BigInteger thread pool, one candidate per task.
+class Primality {
+
+private:
+
+    using limb = BigInteger::limb;
+
+    constexpr static const uint32_t small_prime_limit = 1 << 16;
+
+    static const std::vector<uint32_t>& small_primes() {
+        static const std::vector<uint32_t> primes = []() {
+            std::vector<bool> is_composite(small_prime_limit, false);
+            std::vector<uint32_t> result;
+            for (uint32_t p = 2; p < small_prime_limit; ++p) {
+                if (is_composite[p]) {
+                    continue;
+                }
+                result.push_back(p);
+                for (uint32_t multiple = p * p; multiple < small_prime_limit; multiple += p) {
+                    is_composite[multiple] = true;
+                }
+            }
+            return result;
+        }();
+        return primes;
+    }
+
+    // small primes [first, last) multiplied into one limb, so that one pass over n serves several of them
+    struct PrimeGroup {
+        limb product;
+        size_t first;
+        size_t last;
+    };
 
-    bool is_negative = false;
-    std::vector<int> data;  // each int from 0000 to 9999
-
-    constexpr static const int degree_of_10[6] = {1, 10, 100, 1000, 10000, 100000};
-    constexpr static const int base_size = 4;
-    constexpr static const int base = 10'000;
-    constexpr static const int number3 = 3;
-    constexpr static const int number4 = 4;
-    constexpr static const long double math_pi = 3.1415926535897L;
-    constexpr static const long double half = 0.5L;
-
-    static std::vector<size_t> build_reversed_bits(size_t len, size_t deg2) {
-        std::vector<size_t> reversed_bits(len);
-        for (size_t i = 0; i < len; ++i) {
-            reversed_bits[i] = 0;
-            for (size_t j = 0; j < deg2; ++j) {
-                if (static_cast<bool>((i >> j) & 1)) {
-                    reversed_bits[i] += static_cast<size_t>(1 << (deg2 - 1 - j));
+    static const std::vector<PrimeGroup>& prime_groups() {
+        static const std::vector<PrimeGroup> groups = []() {
+            const std::vector<uint32_t>& primes = small_primes();
+            std::vector<PrimeGroup> result;
+            for (size_t i = 0; i < primes.size();) {
+                PrimeGroup group = {1, i, i};
+                while (group.last < primes.size() && group.product <= ~limb(0) / primes[group.last]) {
+                    group.product *= primes[group.last++];
                 }
+                result.push_back(group);
+                i = group.last;
+            }
+            return result;
+        }();
+        return groups;
+    }
+
+    // n mod p for every small prime p of the table
+    static std::vector<uint32_t> small_prime_residues(const BigInteger& n) {
+        const std::vector<uint32_t>& primes = small_primes();
+        std::vector<uint32_t> residues(primes.size());
+        for (const PrimeGroup& group : prime_groups()) {
+            limb residue = BigInteger::remainder_by_limb(n.data, group.product);
+            for (size_t i = group.first; i < group.last; ++i) {
+                residues[i] = static_cast<uint32_t>(residue % primes[i]);
             }
         }
-        return reversed_bits;
+        return residues;
     }
 
+    // whether a small prime divides n, which is above all of them
+    static bool has_small_factor(const BigInteger& n) {
+        const std::vector<uint32_t>& primes = small_primes();
+        for (const PrimeGroup& group : prime_groups()) {
+            limb residue = BigInteger::remainder_by_limb(n.data, group.product);
+            for (size_t i = group.first; i < group.last; ++i) {
+                if (residue % primes[i] == 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
 
-    static void fast_fourier_transform(std::vector<std::complex<long double>>& polynom, size_t deg2) {
-        size_t len = (1 << deg2);    // polynom array length
-        std::vector<size_t> reversed_bits = build_reversed_bits(len, deg2);    // array of reversed numbers
-        std::vector<std::complex<long double>> phi_pow(len / 2);    // array of phi ^ k
-        phi_pow[0] = 1;
+    // Jacobi symbol (a / n) for odd n > 0
+    static int jacobi(limb a, limb n) {
+        int result = 1;
+        a %= n;
+        while (a != 0) {
+            int zeros = std::countr_zero(a);
+            a >>= zeros;
+            if (zeros % 2 == 1 && (n % 8 == 3 || n % 8 == 5)) {
+                result = -result;
+            }
+            if (a % 4 == 3 && n % 4 == 3) {
+                result = -result;
+            }
+            std::swap(a, n);
+            a %= n;
+        }
+        return (n == 1 ? result : 0);
+    }
 
-        for (size_t i = 0; i < len; ++i) {
-            if (i < reversed_bits[i]) {
-                swap(polynom[i], polynom[reversed_bits[i]]);
+    // Jacobi symbol (a / n) for odd n > 0 through quadratic reciprocity down to limbs
+    static int jacobi(int64_t a, const BigInteger& n) {
+        limb n_low = n.data[0];
+        int result = 1;
+        limb magnitude = static_cast<limb>(a);
+        if (a < 0) {
+            magnitude = limb(0) - magnitude;
+            if (n_low % 4 == 3) {
+                result = -result;
             }
         }
-        for (size_t j = 2; j <= len; j <<= 1) {
-            std::complex<long double> phi = {cosl(2 * math_pi / j), sinl(2 * math_pi / j)};
-            for (size_t i = 1; i < j / 2; ++i) {
-                phi_pow[i] = phi_pow[i - 1] * phi;
+        if (magnitude == 0) {
+            return (n == 1 ? 1 : 0);
+        }
+        int zeros = std::countr_zero(magnitude);
+        magnitude >>= zeros;
+        if (zeros % 2 == 1 && (n_low % 8 == 3 || n_low % 8 == 5)) {
+            result = -result;
+        }
+        if (magnitude % 4 == 3 && n_low % 4 == 3) {
+            result = -result;
+        }
+        return result * jacobi(BigInteger::remainder_by_limb(n.data, magnitude), magnitude);
+    }
+
+    // strong probable prime to base: with n - 1 = d * 2^s, base^d = 1 or base^(d * 2^r) = -1 for some r < s
+    static bool is_strong_probable_prime(ModularArithmetic& arithmetic, const BigInteger& n, const BigInteger& base) {
+        BigInteger n_minus_one = n;
+        --n_minus_one;
+        size_t s = BigInteger::trailing_zero_bits(n_minus_one.data);
+        BigInteger x = arithmetic.powmod(base, n_minus_one >> s);
+        if (x == 1 || x == n_minus_one) {
+            return true;
+        }
+        for (size_t r = 1; r < s; ++r) {
+            x = arithmetic.mulmod(x, x);
+            if (x == n_minus_one) {
+                return true;
             }
-            for (size_t start = 0; start < len; start += j) {
-                auto polynom_it1 = polynom.begin() + static_cast<int>(start);
-                auto polynom_it2 = polynom.begin() + static_cast<int>(start + j / 2);
-                auto polynom_end_it = polynom_it2;
-                auto phi_pow_it = phi_pow.begin();
-                for (; polynom_it1 != polynom_end_it; ++polynom_it1, ++polynom_it2, ++phi_pow_it) {
-                    std::complex<long double> mult = (*phi_pow_it) * (*polynom_it2);
-                    *polynom_it2 = *polynom_it1 - mult;
-                    *polynom_it1 += mult;
-                }
+            if (x == 1) {
+                return false;
             }
         }
+        return false;
     }
 
-    static void polynom_multiplication(std::vector<std::complex<long double>>& p1, 
-                                std::vector<std::complex<long double>>& p2, size_t deg2) {
-        size_t len = (1 << deg2);
-        for (size_t i = 0; i < len; ++i) {
-            p1[i] = {p1[i].real(), p2[i].real()};
+    static void add_mod(BigInteger& x, const BigInteger& y, const BigInteger& n) {
+        x += y;
+        if (x >= n) {
+            x -= n;
         }
+    }
 
-        fast_fourier_transform(p1, deg2);
-        for (size_t i = 0; i < len; ++i) {
-            p1[i] = p1[i] * p1[i];
-            p1[i] = {p1[i].real() / len, p1[i].imag() / len};
+    static void subtract_mod(BigInteger& x, const BigInteger& y, const BigInteger& n) {
+        x -= y;
+        if (x < 0) {
+            x += n;
         }
+    }
 
-        fast_fourier_transform(p1, deg2);
-        std::reverse(p1.begin() + 1, p1.end());
-        for (size_t i = 0; i < len; ++i) {
-            p1[i] = {p1[i].imag() / 2, 0};
+    static void halve_mod(BigInteger& x, const BigInteger& n) {
+        if (x.data[0] & 1) {
+            x += n;
         }
+        x >>= 1;
     }
 
-    size_t optimal_deg2(size_t num_data_size) {
-        size_t this_deg2 = 1;
-        size_t data_size = data.size();
-        while (data_size > 0) {
-            data_size >>= 1;
-            ++this_deg2;
+    // strong Lucas probable prime with Selfridge's parameters: the first D of 5, -7, 9, -11, ... with (D / n) = -1,
+    // P = 1 and Q = (1 - D) / 4. With n + 1 = d * 2^s, U_d = 0 or V_(d * 2^r) = 0 for some r < s.
+    // Everything stays in the internal form of the modular arithmetic, which is linear, so halving works there too.
+    static bool is_strong_lucas_probable_prime(ModularArithmetic& arithmetic, const BigInteger& n) {
+        int64_t d_parameter = 5;
+        for (size_t attempt = 0;; ++attempt) {
+            int symbol = jacobi(d_parameter, n);
+            if (symbol == -1) {
+                break;
+            }
+            if (symbol == 0 && abs(BigInteger(static_cast<int>(d_parameter))) != n) {
+                return false;
+            }
+            // squares have no D with (D / n) = -1
+            if (attempt == 10 && isqrt_rem(n).second == 0) {
+                return false;
+            }
+            d_parameter = (d_parameter > 0 ? -d_parameter - 2 : -d_parameter + 2);
+        }
+        int64_t q_parameter = (1 - d_parameter) / 4;
+
+        BigInteger d_internal = arithmetic.to_internal(BigInteger(static_cast<int>(d_parameter)));
+        BigInteger q_internal = arithmetic.to_internal(BigInteger(static_cast<int>(q_parameter)));
+        BigInteger u = arithmetic.one;    // U_1 = 1
+        BigInteger v = arithmetic.one;    // V_1 = P = 1
+        BigInteger q_power = q_internal;    // Q^k
+        BigInteger product;
+        BigInteger du;
+
+        BigInteger n_plus_one = n;
+        ++n_plus_one;
+        size_t s = BigInteger::trailing_zero_bits(n_plus_one.data);
+        BigInteger d = n_plus_one >> s;
+        for (size_t i = BigInteger::bit_length(d.data) - 1; i-- > 0;) {
+            // U_2k = U_k * V_k, V_2k = V_k^2 - 2 * Q^k
+            arithmetic.multiply(u, v, product);
+            std::swap(u, product);
+            arithmetic.multiply(v, v, product);
+            std::swap(v, product);
+            subtract_mod(v, q_power, n);
+            subtract_mod(v, q_power, n);
+            arithmetic.multiply(q_power, q_power, product);
+            std::swap(q_power, product);
+            if ((d.data[i / BigInteger::limb_bits] >> (i % BigInteger::limb_bits)) & 1) {
+                // U_(k + 1) = (P * U_k + V_k) / 2, V_(k + 1) = (D * U_k + P * V_k) / 2
+                arithmetic.multiply(d_internal, u, du);
+                add_mod(u, v, n);
+                halve_mod(u, n);
+                add_mod(v, du, n);
+                halve_mod(v, n);
+                arithmetic.multiply(q_power, q_internal, product);
+                std::swap(q_power, product);
+            }
+        }
+        if (u.is_zero() || v.is_zero()) {
+            return true;
         }
-        size_t num_deg2 = 1;
-        while (num_data_size > 0) {
-            num_data_size >>= 1;
-            ++num_deg2;
+        for (size_t r = 1; r < s; ++r) {
+            arithmetic.multiply(v, v, product);
+            std::swap(v, product);
+            subtract_mod(v, q_power, n);
+            subtract_mod(v, q_power, n);
+            if (v.is_zero()) {
+                return true;
+            }
+            arithmetic.multiply(q_power, q_power, product);
+            std::swap(q_power, product);
         }
-        return std::max(this_deg2, num_deg2);
+        return false;
     }
 
-    std::vector<std::complex<long double>> build_polynom(size_t poly_size) const {
-        std::vector<std::complex<long double>> poly(poly_size);
-        for (size_t i = 0; i < poly_size; ++i) {
-            if (i < data.size()) {
-                poly[i] = {static_cast<long double>(data[i]), 0};
-            } else {
-                poly[i] = {0, 0};
+    // Baillie-PSW on an odd n above the small prime table
+    static bool passes_baillie_psw(const BigInteger& n) {
+        ModularArithmetic arithmetic(n);
+        return is_strong_probable_prime(arithmetic, n, 2) && is_strong_lucas_probable_prime(arithmetic, n);
+    }
+
+    // offsets i < length with from + i not divisible by a small prime other than itself, from >= 0
+    static std::vector<size_t> sieve_window(const BigInteger& from, size_t length) {
+        const std::vector<uint32_t>& primes = small_primes();
+        std::vector<uint32_t> residues = small_prime_residues(from);
+        std::vector<bool> is_composite(length, false);
+        for (size_t i = 0; i < std::min<size_t>(length, 2); ++i) {
+            is_composite[i] = (from < 2 - static_cast<int>(i));    // 0 and 1
+        }
+        bool is_small = (from < static_cast<int>(small_prime_limit));
+        for (size_t j = 0; j < primes.size(); ++j) {
+            size_t first = (residues[j] == 0 ? 0 : primes[j] - residues[j]);
+            if (is_small && from.data[0] <= primes[j]) {
+                first = 2 * primes[j] - from.data[0];    // the prime itself stays, 0 is marked above
+            }
+            for (size_t i = first; i < length; i += primes[j]) {
+                is_composite[i] = true;
             }
         }
-        return poly;
+        std::vector<size_t> offsets;
+        for (size_t i = 0; i < length; ++i) {
+            if (!is_composite[i]) {
+                offsets.push_back(i);
+            }
+        }
+        return offsets;
     }
-    
-    static void fix_polynom(std::vector<std::complex<long double>>& poly) {
-        size_t poly_size = poly.size();
-        for (size_t i = 0; ; ++i) {
-            poly[i].real(static_cast<long long>(poly[i].real() + half));
-            if (poly[i].real() < base) {
-                if (i >= poly_size - 1) {
-                    break;
+
+    // a candidate that has been through trial division or the sieve
+    static bool is_sieved_probable_prime(const BigInteger& n) {
+        if (n < static_cast<int>(small_prime_limit)) {
+            return std::binary_search(small_primes().begin(), small_primes().end(), static_cast<uint32_t>(n.data[0]));
+        }
+        return passes_baillie_psw(n);
+    }
+
+    // result[i] = test(candidates[i]) with one candidate per task
+    template<typename Test>
+    static std::vector<bool> test_all(const std::vector<BigInteger>& candidates, Test test) {
+        std::vector<char> results(candidates.size(), 0);
+        BigInteger::parallel_for(candidates.size(), parallel_testing().threads, [&](size_t i) {
+            results[i] = static_cast<char>(test(candidates[i]));
+        });
+        return std::vector<bool>(results.begin(), results.end());
+    }
+
+public:
+
+    // threads that test the candidates of a batch, a range or a next_prime window
+    struct ParallelTesting {
+        size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+    };
+
+    static ParallelTesting& parallel_testing() {
+        static ParallelTesting settings;
+        return settings;
+    }
+
+    static bool is_probable_prime(const BigInteger& n) {
+        if (n < static_cast<int>(small_prime_limit)) {
+            return n >= 2 && std::binary_search(small_primes().begin(), small_primes().end(), static_cast<uint32_t>(n.data[0]));
+        }
+        if (has_small_factor(n)) {
+            return false;
+        }
+        if (n.data.size() == 1 && n.data[0] / small_prime_limit < small_prime_limit) {
+            return true;    // no factor below the square root
+        }
+        return passes_baillie_psw(n);
+    }
+
+    // the strong probable prime test alone, for an odd n > 2 and any base
+    static bool is_strong_probable_prime(const BigInteger& n, const BigInteger& base) {
+        ModularArithmetic arithmetic(n);
+        return is_strong_probable_prime(arithmetic, n, base);
+    }
+
+    static std::vector<bool> are_probable_primes(const std::vector<BigInteger>& candidates) {
+        return test_all(candidates, [](const BigInteger& n) {
+            return is_probable_prime(n);
+        });
+    }
+
+    // probable primes in [from, from + length), sieved by the small primes first
+    static std::vector<BigInteger> probable_primes_in(const BigInteger& from, size_t length) {
+        BigInteger start = (from < 0 ? BigInteger(0) : from);
+        if (from < 0) {
+            BigInteger skipped = -from;
+            if (skipped >= BigInteger::from_limbs({length})) {
+                return {};
+            }
+            length -= skipped.data[0];
+        }
+        std::vector<BigInteger> candidates;
+        for (size_t offset : sieve_window(start, length)) {
+            candidates.push_back(start + BigInteger::from_limbs({offset}));
+        }
+        std::vector<bool> is_prime = test_all(candidates, is_sieved_probable_prime);
+        std::vector<BigInteger> primes;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (is_prime[i]) {
+                primes.push_back(std::move(candidates[i]));
+            }
+        }
+        return primes;
+    }
+
+    // the smallest probable prime above n: the sieve runs on windows of some dozens of expected prime gaps
+    // and the survivors are tested in rounds of one candidate per thread
+    static BigInteger next_prime(const BigInteger& n) {
+        BigInteger start = (n < 2 ? BigInteger(2) : n + 1);
+        size_t length = std::max<size_t>(256, 32 * BigInteger::bit_length(start.data));
+        size_t round = std::max<size_t>(parallel_testing().threads, 1);
+        while (true) {
+            std::vector<size_t> offsets = sieve_window(start, length);
+            for (size_t first = 0; first < offsets.size(); first += round) {
+                std::vector<BigInteger> candidates;
+                for (size_t i = first; i < std::min(first + round, offsets.size()); ++i) {
+                    candidates.push_back(start + BigInteger::from_limbs({offsets[i]}));
                 }
-            } else {
-                if (i + 1 == poly.size()) {
-                    poly.push_back({0, 0});
+                std::vector<bool> is_prime = test_all(candidates, is_sieved_probable_prime);
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                    if (is_prime[i]) {
+                        return candidates[i];
+                    }
                 }
-                poly[i + 1].real(poly[i + 1].real() + static_cast<long long>(poly[i].real()) / base);
-                poly[i].real(static_cast<long long>(poly[i].real()) % base);
             }
+            start += BigInteger::from_limbs({length});
         }
     }
 
-    void clean_trailing_zeros() {
-        while(data.size() > 1 && data.back() == 0) {
-            data.pop_back();
+    // a uniformly placed probable prime of exactly bits bits, bits >= 2
+    template<typename Generator>
+    static BigInteger random_prime(size_t bits, Generator& generator) {
+        std::uniform_int_distribution<limb> distribution;
+        size_t size = (bits + BigInteger::limb_bits - 1) / BigInteger::limb_bits;
+        while (true) {
+            BigInteger::LimbVector limbs(size, 0);
+            for (limb& value : limbs) {
+                value = distribution(generator);
+            }
+            size_t top_bits = bits - (size - 1) * BigInteger::limb_bits;
+            if (top_bits < BigInteger::limb_bits) {
+                limbs.back() &= (limb(1) << top_bits) - 1;
+            }
+            limbs.back() |= limb(1) << (top_bits - 1);
+            BigInteger prime = next_prime(BigInteger::from_limbs(std::move(limbs)) - 1);
+            if (BigInteger::bit_length(prime.data) == bits) {
+                return prime;
+            }
         }
     }
 
-    bool is_zero() const {
-        return (data.size() == 1 && data[0] == 0);
+};
+
+bool is_probable_prime(const BigInteger& n) {
+    return Primality::is_probable_prime(n);
+}
+
+BigInteger next_prime(const BigInteger& n) {
+    return Primality::next_prime(n);
+}
+
+
+
+class Rational {
+
+private:
+
+    BigInteger numerator;
+    BigInteger denominator;    // always positive
+    bool is_normalized = true;    // numerator and denominator are coprime
+
+    void reduce() {
+        BigInteger greatest_common_divisor = gcd(numerator, denominator);
+        if (greatest_common_divisor != 1) {
+            numerator /= greatest_common_divisor;
+            denominator /= greatest_common_divisor;
+        }
+        is_normalized = true;
+    }
+
+    bool is_eager() const {
+        return is_normalized && !deferred_normalization();
     }
 
-    std::strong_ordering is_lt_modulo(const BigInteger& num) const {
-        if (data.size() < num.data.size()) {
+    // the order of |a| * |d| and |c| * |b| without the products: first from the bit lengths, then from
+    // bounds on the products of the leading 63 bits of each factor; nothing when the bounds overlap
+    static std::optional<std::strong_ordering> estimate_cross_order(const BigInteger& a, const BigInteger& d,
+                                                                   const BigInteger& c, const BigInteger& b) {
+        using double_limb = BigInteger::double_limb;
+        int64_t left_bits = static_cast<int64_t>(BigInteger::bit_length(a.data) + BigInteger::bit_length(d.data));
+        int64_t right_bits = static_cast<int64_t>(BigInteger::bit_length(c.data) + BigInteger::bit_length(b.data));
+        // a product of x-bit and y-bit factors has x + y - 1 or x + y bits
+        if (left_bits > right_bits + 1) {
+            return std::strong_ordering::greater;
+        }
+        if (right_bits > left_bits + 1) {
             return std::strong_ordering::less;
         }
-        if (data.size() > num.data.size()) {
+        int64_t exponents[4];
+        bool exact[4];
+        double_limb leading[4];
+        const BigInteger* factors[4] = {&a, &d, &c, &b};
+        for (size_t i = 0; i < 4; ++i) {
+            leading[i] = BigInteger::leading_bits(factors[i]->data, 63, exponents[i], exact[i]);
+        }
+        // each factor lies in [leading, leading + 1) * 2^exponent, or is leading * 2^exponent when exact
+        double_limb left_lower = leading[0] * leading[1];
+        double_limb left_upper = (leading[0] + !exact[0]) * (leading[1] + !exact[1]);
+        double_limb right_lower = leading[2] * leading[3];
+        double_limb right_upper = (leading[2] + !exact[2]) * (leading[3] + !exact[3]);
+        // the exponents differ as the bit lengths do, by one at most
+        if (left_bits > right_bits) {
+            left_lower <<= 1;
+            left_upper <<= 1;
+        } else if (right_bits > left_bits) {
+            right_lower <<= 1;
+            right_upper <<= 1;
+        }
+        if (left_lower > right_upper) {
             return std::strong_ordering::greater;
         }
-        for (size_t i = data.size() - 1; i < data.size(); --i) {
-            if (data[i] < num.data[i]) {
-                return std::strong_ordering::less;
-            }
-            if (data[i] > num.data[i]) {
-                return std::strong_ordering::greater;
-            };
+        if (left_upper < right_lower) {
+            return std::strong_ordering::less;
+        }
+        if (exact[0] && exact[1] && exact[2] && exact[3]) {
+            return left_lower <=> right_lower;
         }
-        return std::strong_ordering::greater;
+        return std::nullopt;
     }
 
-    /*void add_one_modulo() {
-        ++data[0];
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (data[i] == base) {
-                data[i] = 0;
-                if (i + 1 == data.size()) {
-                    data.push_back(0);
-                }
-                ++data[i + 1];
-            } else {
-                break;
-            }
+public:
+
+    Rational(): numerator(0), denominator(1) {}
+    // Rational(const Rational& other): numerator(other.numerator), denominator(other.denominator) {}
+    Rational(const BigInteger& n): numerator(n), denominator(1) {}
+    Rational(int number) {
+        *this = Rational(BigInteger(number));
+    }
+
+    // when set, arithmetic skips the gcds and leaves reduction to normalize(), toString() and ==
+    static bool& deferred_normalization() {
+        static bool deferred = false;
+        return deferred;
+    }
+
+    void normalize() {
+        if (!is_normalized) {
+            reduce();
         }
     }
 
-    void subtract_one_modulo() {
-        if (data.size() == 1 && data[0] == 0) {
-            data[0] = 1;
-            is_negative = !is_negative;
-            return;
+    auto operator <=> (const Rational& num) const {
+        int sign = (numerator.is_zero() ? 0 : (numerator.is_negative ? -1 : 1));
+        int other_sign = (num.numerator.is_zero() ? 0 : (num.numerator.is_negative ? -1 : 1));
+        if (sign != other_sign || sign == 0) {
+            return sign <=> other_sign;
         }
-        --data[0];
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (data[i] == -1) {
-                data[i] = base - 1;
-                --data[i + 1];
-            } else {
-                break;
-            }
+        if (denominator == num.denominator) {
+            return numerator <=> num.numerator;
         }
-        clean_trailing_zeros();
-        if (is_zero() && is_negative) {
-            is_negative = false;
+        std::optional<std::strong_ordering> order = estimate_cross_order(numerator, num.denominator, num.numerator, denominator);
+        if (!order) {
+            BigInteger left = numerator * num.denominator;
+            BigInteger right = denominator * num.numerator;
+            return left <=> right;
         }
-    }*/
+        return (sign > 0 ? *order : 0 <=> *order);
+    }
 
-    void add_bigint_modulo(const BigInteger& num) {
-        for (size_t i = 0; i < num.data.size(); ++i) {
-            if (i == data.size()) {
-                data.push_back(num.data[i]);
-            } else {
-                data[i] += num.data[i];
-            }
+    bool operator == (const Rational& num) const {
+        if (is_normalized && num.is_normalized) {
+            return numerator == num.numerator && denominator == num.denominator;
         }
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (data[i] < base) {
-                if (i >= num.data.size() - 1) {
-                    break;
-                }
+        return numerator * num.denominator == denominator * num.numerator;
+    }
+
+    std::string toString() const {
+        if (!is_normalized) {
+            Rational copy = *this;
+            copy.reduce();
+            return copy.toString();
+        }
+        std::string res = numerator.toString();
+        if (denominator != 1) {
+            res += "/" + denominator.toString();
+        }
+        return res;
+    }
+
+    // Rational& operator = (const Rational& num) = default;
+
+    Rational operator - () const {
+        Rational copy = *this;
+        copy.numerator.change_sign();
+        return copy;
+    }
+
+    // Henrici's addition: only the gcd of the denominators and a gcd with it are needed for reduced operands
+    Rational& operator += (const Rational& num) {
+        if (!is_eager() || !num.is_normalized) {
+            numerator = numerator * num.denominator + denominator * num.numerator;
+            denominator *= num.denominator;
+            is_normalized = false;
+            if (!deferred_normalization()) {
+                reduce();
             }
-            int overflow = data[i] / base;
-            if (overflow > 0) {
-                data[i] %= base;
-                if (i + 1 == data.size()) {
-                    data.push_back(overflow);
-                } else {
-                    data[i + 1] += overflow;
-                }
+            return *this;
+        }
+        BigInteger common = gcd(denominator, num.denominator);
+        if (common == 1) {
+            numerator = numerator * num.denominator + denominator * num.numerator;
+            denominator *= num.denominator;
+            return *this;
+        }
+        BigInteger other_denominator = num.denominator / common;
+        BigInteger sum = numerator * other_denominator + (denominator / common) * num.numerator;
+        BigInteger sum_common = gcd(sum, common);
+        if (sum_common != 1) {
+            sum /= sum_common;
+            denominator /= sum_common;
+        }
+        numerator = std::move(sum);
+        denominator *= other_denominator;
+        return *this;
+    }
+
+    Rational& operator -= (const Rational& num) {
+        return *this += -num;
+    }
+
+    // cross-cancellation: the gcds are taken between a numerator and the other denominator, which are smaller
+    Rational& operator *= (const Rational& num) {
+        if (!is_eager() || !num.is_normalized) {
+            numerator *= num.numerator;
+            denominator *= num.denominator;
+            is_normalized = false;
+            if (!deferred_normalization()) {
+                reduce();
             }
+            return *this;
+        }
+        BigInteger left_common = gcd(numerator, num.denominator);
+        BigInteger right_common = gcd(num.numerator, denominator);
+        BigInteger other_numerator = num.numerator;
+        BigInteger other_denominator = num.denominator;
+        if (left_common != 1) {
+            numerator /= left_common;
+            other_denominator /= left_common;
         }
+        if (right_common != 1) {
+            other_numerator /= right_common;
+            denominator /= right_common;
+        }
+        numerator *= other_numerator;
+        denominator *= other_denominator;
+        return *this;
     }
 
-    void subtract_bigint_modulo(const BigInteger& num) { 
-        int lt_factor = (is_lt_modulo(num) == std::strong_ordering::less ? 1 : -1);
-        if (lt_factor == 1) {
-            is_negative = !is_negative;
+    Rational& operator /= (const Rational& num) {
+        Rational inverse;
+        inverse.numerator = num.denominator;
+        inverse.denominator = num.numerator;
+        inverse.is_normalized = num.is_normalized;
+        if (inverse.denominator < 0) {
+            inverse.numerator.change_sign();
+            inverse.denominator.change_sign();
         }
+        return *this *= inverse;
+    }
 
-        for (size_t i = 0; i < num.data.size(); ++i) {
-            if (i == data.size()) {
-                data.push_back(num.data[i] * lt_factor);
-            } else {
-                data[i] = (data[i] - num.data[i]) * -lt_factor;
-            }
+    // asDecimal in pieces: the integer part with the dot, then the fraction digits in chunks of about
+    // the denominator's length, each from the running remainder alone
+    template<typename Output>
+    void asDecimal(size_t precision, Output&& output) const {
+        auto [quotient, remainder] = divmod(numerator, denominator);
+        std::string chunk = quotient.toString();
+        if (precision == 0) {
+            output(std::string_view(chunk));
+            return;
         }
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (i >= num.data.size() && data[i] >= 0) {
-                break;
-            }
-            if (data[i] < 0) {
-                data[i] += base;
-                --data[i + 1];
-            }
+        if (numerator < 0 && quotient.is_zero()) {
+            chunk.insert(chunk.begin(), '-');
         }
-        clean_trailing_zeros();
-        if (is_zero() && is_negative) {
-            is_negative = false;
+        chunk.push_back('.');
+        output(std::string_view(chunk));
+        remainder.is_negative = false;
+        size_t chunk_digits = std::max<size_t>(BigInteger::decimal_chunk_size, denominator.decimal_digits_bound());
+        while (precision > 0) {
+            size_t digits = std::min(precision, chunk_digits);
+            remainder.shift(digits);
+            auto [block, rest] = divmod(remainder, denominator);
+            remainder = std::move(rest);
+            chunk = block.toString();
+            chunk.insert(chunk.begin(), digits - chunk.size(), '0');
+            output(std::string_view(chunk));
+            precision -= digits;
+        }
+    }
+
+    // the value truncated to precision decimal places
+    std::string asDecimal(size_t precision = 0) const {
+        std::string result;
+        asDecimal(precision, [&result](std::string_view chunk) {
+            result += chunk;
+        });
+        return result;
+    }
+
+    // correctly rounded to nearest from the leading bits of the numerator and denominator
+    double to_double() const {
+        return BigInteger::quotient_to_double(numerator, denominator);
+    }
+
+    explicit operator double() const {
+        return to_double();
+    }
+
+    friend size_t binary_size(const Rational& value);
+    friend std::byte* to_bytes(std::byte* out, const Rational& value);
+    friend from_bytes_result from_bytes(std::span<const std::byte> bytes, Rational& value);
+    friend class BigFloat;
+
+};
+
+Rational operator + (const Rational& n1, const Rational& n2) {
+    Rational n1_copy = n1;
+    return n1_copy += n2;
+}
+
+Rational operator - (const Rational& n1, const Rational& n2) {
+    Rational n1_copy = n1;
+    return n1_copy -= n2;
+}
+
+Rational operator * (const Rational& n1, const Rational& n2) {
+    Rational n1_copy = n1;
+    return n1_copy *= n2;
+}
+
+Rational operator / (const Rational& n1, const Rational& n2) {
+    Rational n1_copy = n1;
+    return n1_copy /= n2;
+}
+
+// a Rational is written as its reduced numerator and denominator
+size_t binary_size(const Rational& value) {
+    if (!value.is_normalized) {
+        Rational copy = value;
+        copy.reduce();
+        return binary_size(copy);
+    }
+    return binary_size(value.numerator) + binary_size(value.denominator);
+}
+
+std::byte* to_bytes(std::byte* out, const Rational& value) {
+    if (!value.is_normalized) {
+        Rational copy = value;
+        copy.reduce();
+        return to_bytes(out, copy);
+    }
+    return to_bytes(to_bytes(out, value.numerator), value.denominator);
+}
+
+// the numerator and denominator are trusted to be coprime, as to_bytes writes them
+from_bytes_result from_bytes(std::span<const std::byte> bytes, Rational& value) {
+    BigInteger numerator;
+    BigInteger denominator;
+    from_bytes_result result = from_bytes(bytes, numerator);
+    if (result.ec != std::errc()) {
+        return result;
+    }
+    result = from_bytes(bytes.subspan(static_cast<size_t>(result.ptr - bytes.data())), denominator);
+    if (result.ec != std::errc()) {
+        return {bytes.data(), result.ec};
+    }
+    if (denominator <= 0) {
+        return {bytes.data(), std::errc::invalid_argument};
+    }
+    value.numerator = std::move(numerator);
+    value.denominator = std::move(denominator);
+    value.is_normalized = true;
+    return result;
+}
+
+// Batches are a little-endian 64-bit count followed by the values. T is BigInteger or Rational,
+// decoding also takes BigIntegerView to leave the limbs of a whole batch in place.
+
+template<typename T>
+size_t binary_size(const std::vector<T>& values) {
+    size_t size = sizeof(uint64_t);
+    for (const T& value : values) {
+        size += binary_size(value);
+    }
+    return size;
+}
+
+template<typename T>
+std::byte* to_bytes(std::byte* out, const std::vector<T>& values) {
+    uint64_t count = values.size();
+    if constexpr (std::endian::native != std::endian::little) {
+        count = __builtin_bswap64(count);
+    }
+    std::memcpy(out, &count, sizeof(uint64_t));
+    out += sizeof(uint64_t);
+    for (const T& value : values) {
+        out = to_bytes(out, value);
+    }
+    return out;
+}
+
+// replaces the contents of values, which are left as they were on error
+template<typename T>
+from_bytes_result from_bytes(std::span<const std::byte> bytes, std::vector<T>& values) {
+    if (bytes.size() < sizeof(uint64_t)) {
+        return {bytes.data(), std::errc::invalid_argument};
+    }
+    uint64_t count;
+    std::memcpy(&count, bytes.data(), sizeof(uint64_t));
+    if constexpr (std::endian::native != std::endian::little) {
+        count = __builtin_bswap64(count);
+    }
+    // every value takes at least one word, so a larger count cannot be right
+    if (count > bytes.size() / sizeof(uint64_t) - 1) {
+        return {bytes.data(), std::errc::invalid_argument};
+    }
+    std::vector<T> result(count);
+    const std::byte* position = bytes.data() + sizeof(uint64_t);
+    const std::byte* end = bytes.data() + bytes.size();
+    for (T& value : result) {
+        from_bytes_result step = from_bytes(std::span<const std::byte>(position, end), value);
+        if (step.ec != std::errc()) {
+            return {bytes.data(), step.ec};
         }
+        position = step.ptr;
     }
+    values = std::move(result);
+    return {position, std::errc()};
+}
+
+// Binary floating point number mantissa * 2^exponent. Every result is rounded to context().precision bits
+// with context().rounding, the mantissa is kept odd so that equal values have equal representations.
+class BigFloat {
+
+public:
+
+    enum class RoundingMode {
+        to_nearest,    // ties to even
+        toward_zero,
+        downward,
+        upward
+    };
+
+    struct Context {
+        size_t precision = 256;    // mantissa bits
+        RoundingMode rounding = RoundingMode::to_nearest;
+    };
+
+private:
 
-    void change_by_bigint_modulo(const BigInteger& num, bool are_adding) {
-        if (are_adding) {
-            add_bigint_modulo(num);
-        } else {
-            subtract_bigint_modulo(num);
-        }
-    } 
+    BigInteger mantissa;
+    int64_t exponent = 0;
 
-    void solve_first_division_case(const BigInteger& num, BigInteger& result) {
-        for (int i = 1; i < degree_of_10[1]; ++i) {
-            *this -= num;
-            if (*this < num) {
-                result += BigInteger(i);
-                break;
-            }
+    static void normalize(BigInteger& mantissa, int64_t& exponent) {
+        if (mantissa.is_zero()) {
+            exponent = 0;
+            return;
+        }
+        size_t zero_bits = BigInteger::trailing_zero_bits(mantissa.data);
+        if (zero_bits != 0) {
+            BigInteger::shift_right_in_place(mantissa.data, zero_bits);
+            exponent += static_cast<int64_t>(zero_bits);
         }
     }
-    void solve_second_division_case(const BigInteger& num, BigInteger& result, 
-                                    size_t digits_number, size_t num_digits_number) {
-        BigInteger num_shifted = num;
-        num_shifted.shift(digits_number - num_digits_number - 1);
-        BigInteger num_shifted_again = num_shifted;
-        num_shifted_again.shift(1);
-        if (*this < num_shifted_again) {
-            for (int i = 1; i < degree_of_10[1]; ++i) {
-                *this -= num_shifted;
-                if (*this < num_shifted) {
-                    BigInteger i_shifted(i);
-                    i_shifted.shift(digits_number - num_digits_number - 1);
-                    result += i_shifted;
+
+    // rounds mantissa * 2^exponent to a multiple of 2^lowest_exponent
+    static void round_to(BigInteger& mantissa, int64_t& exponent, int64_t lowest_exponent, RoundingMode mode) {
+        if (!mantissa.is_zero() && exponent < lowest_exponent) {
+            size_t shift = static_cast<size_t>(lowest_exponent - exponent);
+            size_t bits = BigInteger::bit_length(mantissa.data);
+            bool half = (shift <= bits && ((mantissa.data[(shift - 1) / BigInteger::limb_bits] >> ((shift - 1) % BigInteger::limb_bits)) & 1) != 0);
+            bool sticky = (BigInteger::trailing_zero_bits(mantissa.data) < shift - 1);
+            BigInteger::shift_right_in_place(mantissa.data, shift);
+            bool away = false;
+            switch (mode) {
+                case RoundingMode::to_nearest:
+                    away = half && (sticky || (mantissa.data[0] & 1) != 0);
                     break;
-                }
-            }
-        } else {
-            for (int i = 1; i < degree_of_10[1]; ++i) {
-                *this -= num_shifted_again;
-                if (*this < num_shifted_again) {
-                    BigInteger i_shifted(i);
-                    i_shifted.shift(digits_number - num_digits_number);
-                    result += i_shifted;
+                case RoundingMode::toward_zero:
+                    break;
+                case RoundingMode::downward:
+                    away = mantissa.is_negative && (half || sticky);
+                    break;
+                case RoundingMode::upward:
+                    away = !mantissa.is_negative && (half || sticky);
                     break;
-                }
-            }
-        }
-    } 
-    
-    void add_new_data_to_begin(std::vector<int>& new_data, size_t pack_idx, size_t rem) {
-        size_t digits_number = static_cast<size_t>(get_digits_number());
-        for (size_t i = 0, data_rem = 0; i < digits_number; ++i, data_rem = (data_rem == base_size - 1 ? 0 : data_rem + 1)) {
-            if (rem == 0) {
-                new_data.push_back(0);
             }
-            int digit = data[i / base_size] / degree_of_10[data_rem] % degree_of_10[1];
-            new_data[pack_idx] += digit * degree_of_10[rem];
-            ++rem;
-            if (rem == base_size) {
-                rem = 0;
-                ++pack_idx;
+            if (away) {
+                mantissa.increment_magnitude();
             }
+            mantissa.is_negative = (mantissa.is_negative && !mantissa.is_zero());
+            exponent = lowest_exponent;
         }
-        std::swap(data, new_data);
+        normalize(mantissa, exponent);
     }
 
-public:
-
-    BigInteger() {
-        is_negative = false;
-        data = {0};
+    static int64_t top_bit(const BigInteger& mantissa, int64_t exponent) {
+        return exponent + static_cast<int64_t>(BigInteger::bit_length(mantissa.data));
     }
 
-    // BigInteger(const BigInteger& other): is_negative(other.is_negative), data(other.data) {}
-
-    BigInteger(int number) {
-        is_negative = false;
-        if (number < 0) {
-            is_negative = true;
-            number = -number;
+    void round() {
+        if (mantissa.is_zero()) {
+            exponent = 0;
+            return;
         }
-        do {
-            data.push_back(number % base);
-            number /= base;
-        } while (number > 0);
+        int64_t lowest_exponent = top_bit(mantissa, exponent) - static_cast<int64_t>(context().precision);
+        round_to(mantissa, exponent, lowest_exponent, context().rounding);
     }
 
-    BigInteger(const std::string& str) {
-        if (str[0] == '-' && str != "-0") {
-            is_negative = true;
-        }
-        size_t pack_idx = 0;
-        size_t rem = 0;
-        for (auto it = str.rbegin(); it != str.rend() && *it != '-'; ++it) {
-            if (rem == 0) {
-                data.push_back(0);
-            }
-            data[pack_idx] += (*it - '0') * degree_of_10[rem];
-            ++rem;
-            if (rem == base_size) {
-                rem = 0;
-                ++pack_idx;
-            }
+    // n1 * 2^e1 / n2 * 2^e2 from a quotient of precision + 2 bits and a sticky bit for the remainder
+    static BigFloat quotient(const BigInteger& n1, int64_t e1, const BigInteger& n2, int64_t e2) {
+        int64_t shift = static_cast<int64_t>(context().precision + 2 + BigInteger::bit_length(n2.data)) -
+            static_cast<int64_t>(BigInteger::bit_length(n1.data));
+        shift = std::max<int64_t>(shift, 0);
+        BigInteger shifted = n1;
+        shifted <<= static_cast<size_t>(shift);
+        auto [q, r] = divmod(shifted, n2);
+        BigFloat result;
+        result.mantissa = std::move(q);
+        result.mantissa <<= 1;
+        if (!r.is_zero()) {
+            result.mantissa.increment_magnitude();
         }
-        clean_trailing_zeros();
+        result.exponent = e1 - e2 - shift - 1;
+        result.round();
+        return result;
     }
 
-    std::strong_ordering operator <=> (const BigInteger& other) const {
-        std::strong_ordering sign_ordering = static_cast<int>(other.is_negative) <=> static_cast<int>(is_negative);
-        if (is_negative != other.is_negative) {
-            return sign_ordering;
-        }
-        /*if (is_negative && !other.is_negative) {
-            return std::strong_ordering::less;
+    // the integer square root of a mantissa of 2 * (precision + 2) bits, with a sticky bit for the remainder
+    static BigFloat square_root(const BigFloat& num) {
+        if (num.mantissa.is_zero()) {
+            return num;
         }
-        if (!is_negative && other.is_negative) {
-            return std::strong_ordering::greater;
-        }*/
-        if (data.size() != other.data.size()) {
-            bool size_comp_factor = data.size() < other.data.size();
-            return ((size_comp_factor != is_negative) ? std::strong_ordering::less : std::strong_ordering::greater);
+        BigInteger shifted = num.mantissa;
+        int64_t exponent = num.exponent;
+        size_t bits = BigInteger::bit_length(shifted.data);
+        size_t wanted_bits = 2 * (context().precision + 2);
+        size_t shift = (bits < wanted_bits ? wanted_bits - bits : 0);
+        shift += (static_cast<uint64_t>(exponent) - shift) & 1;
+        shifted <<= shift;
+        exponent -= static_cast<int64_t>(shift);
+        auto [root, remainder] = isqrt_rem(shifted);
+        BigFloat result;
+        result.mantissa = std::move(root);
+        result.mantissa <<= 1;
+        if (!remainder.is_zero()) {
+            result.mantissa.increment_magnitude();
         }
+        result.exponent = exponent / 2 - 1;
+        result.round();
+        return result;
+    }
 
-        for (size_t i = data.size() - 1; i < data.size(); --i) {
-            if (data[i] != other.data[i]) {
-                bool data_comp_factor = data[i] < other.data[i];
-                return ((data_comp_factor != is_negative) ? std::strong_ordering::less : std::strong_ordering::greater);
-            }
-        }
-        return std::strong_ordering::equal;
+public:
+
+    static Context& context() {
+        static Context current;
+        return current;
     }
 
-    bool operator == (const BigInteger& other) const = default;
-        /*{
-        if (data.size() != other.data.size()) {
-            return false;
-        }
-        if (is_negative != other.is_negative) {
-            return false;
-        }
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (data[i] != other.data[i]) {
-                return false;
-            }
-        }
-        return true;
-    }*/
+    BigFloat() = default;
 
-    /*bool operator != (const BigInteger& other) const {
-        return !(*this == other);
-    }*/
+    BigFloat(const BigInteger& n): mantissa(n) {
+        round();
+    }
 
-    std::string toString() const {
-        std::string res;
-        for (auto it = data.rbegin(); it != data.rend(); ++it) {
-            int num = (*it);
-            res += char('0' + num / degree_of_10[1 + 2] % degree_of_10[1]);
-            res += char('0' + num / degree_of_10[2] % degree_of_10[1]);
-            res += char('0' + num / degree_of_10[1] % degree_of_10[1]);
-            res += char('0' + num % degree_of_10[1]);
-        }
-        size_t begin_without_0 = 0;
-        while (begin_without_0 < res.size() && res[begin_without_0] == '0') {
-            ++begin_without_0;
-        }
-        res = (is_negative ? "-" : "") + res.substr(begin_without_0, res.size() - begin_without_0 );
-        if (res == "-" || res.empty()) {
-            res = "0";
+    // exact before rounding, value must be finite
+    BigFloat(double value) {
+        if (value == 0) {
+            return;
         }
-        return res;
+        int binary_exponent;
+        double fraction = std::frexp(value, &binary_exponent);
+        mantissa = BigInteger::from_int64(static_cast<int64_t>(std::ldexp(fraction, 53)));
+        exponent = binary_exponent - 53;
+        round();
     }
 
-    void change_sign() {
-        is_negative = !is_negative;
+    BigFloat(int value): BigFloat(BigInteger(value)) {}
+
+    explicit BigFloat(const Rational& num) {
+        *this = quotient(num.numerator, 0, num.denominator, 0);
     }
 
-    int get_digits_number() const {
-        if (data.back() / degree_of_10[number3] % degree_of_10[1] != 0) {
-            return base_size * static_cast<int>(data.size() - 1) + number4;
-        }
-        if (data.back() / degree_of_10[2] % degree_of_10[1] != 0) {
-            return base_size * static_cast<int>(data.size() - 1) + number3;
-        }
-        if (data.back() / degree_of_10[1] % degree_of_10[1] != 0) {
-            return base_size * static_cast<int>(data.size() - 1) + 2;
-        }
-        return base_size * static_cast<int>(data.size() - 1) + 1;
+    const BigInteger& get_mantissa() const {
+        return mantissa;
     }
 
-    void shift(size_t pow10) {
-        if (*this == 0) {
-            return;
+    int64_t get_exponent() const {
+        return exponent;
+    }
+
+    BigFloat operator - () const {
+        BigFloat copy = *this;
+        copy.mantissa.change_sign();
+        return copy;
+    }
+
+    // an operand below the rounding position of the other is replaced by a power of two under it,
+    // which rounds the same way and keeps the exact sum short
+    BigFloat& operator += (const BigFloat& num) {
+        if (num.mantissa.is_zero()) {
+            return *this;
+        }
+        if (mantissa.is_zero()) {
+            mantissa = num.mantissa;
+            exponent = num.exponent;
+            round();
+            return *this;
         }
-        std::vector<int> new_data;
-        size_t pack_idx = 0;
-        size_t rem = 0;
-        for (size_t i = 0; i < pow10; ++i) {
-            if (rem == 0) {
-                new_data.push_back(0);
+        BigInteger other = num.mantissa;
+        int64_t other_exponent = num.exponent;
+        int64_t top = top_bit(mantissa, exponent);
+        int64_t other_top = top_bit(other, other_exponent);
+        int64_t precision = static_cast<int64_t>(context().precision);
+        if (top < other_top) {
+            int64_t limit = std::min(other_exponent, other_top - precision) - 3;
+            if (top <= limit) {
+                mantissa = BigInteger(mantissa.is_negative ? -1 : 1);
+                exponent = limit - 1;
             }
-            new_data[pack_idx] = 0;
-            ++rem;
-            if (rem == base_size) {
-                rem = 0;
-                ++pack_idx;
+        } else {
+            int64_t limit = std::min(exponent, top - precision) - 3;
+            if (other_top <= limit) {
+                other = BigInteger(other.is_negative ? -1 : 1);
+                other_exponent = limit - 1;
             }
         }
-        add_new_data_to_begin(new_data, pack_idx, rem);
-    }
-
-    /*BigInteger& operator = (const BigInteger& other) {
-        is_negative = other.is_negative;
-        data = other.data;
-        return *this;
-    }*/
-
-    BigInteger operator - () const {
-        BigInteger num = *this;
-        if (!is_zero()) {
-            num.is_negative = !is_negative;
+        if (exponent > other_exponent) {
+            mantissa <<= static_cast<size_t>(exponent - other_exponent);
+            exponent = other_exponent;
+        } else {
+            other <<= static_cast<size_t>(other_exponent - exponent);
         }
-        return num;
-    }
-
-    BigInteger& operator += (const BigInteger& num) {
-        change_by_bigint_modulo(num, is_negative == num.is_negative);
+        mantissa += other;
+        round();
         return *this;
     }
 
-    BigInteger& operator -= (const BigInteger& num) {
+    BigFloat& operator -= (const BigFloat& num) {
         return *this += -num;
     }
 
-    BigInteger& operator ++ () {
-        return *this += 1;
-        /*if (!is_negative) {
-            *this += 1;
-            add_one_modulo();
-        } else {
-            subtract_one_modulo();
-        }
-        return *this;*/
+    BigFloat& operator *= (const BigFloat& num) {
+        mantissa *= num.mantissa;
+        exponent += num.exponent;
+        round();
+        return *this;
     }
 
-    BigInteger operator ++ (int) {
-        BigInteger return_value = *this;
-        ++(*this);
-        return return_value;
-    }
-    
-    BigInteger& operator -- () {
-        return *this -= 1;
-        /*if (is_negative) {
-            add_one_modulo();
-        } else {
-            subtract_one_modulo();
+    // the divisor must not be zero
+    BigFloat& operator /= (const BigFloat& num) {
+        if (!mantissa.is_zero()) {
+            *this = quotient(mantissa, exponent, num.mantissa, num.exponent);
         }
-        return *this;*/
+        return *this;
     }
 
-    BigInteger operator -- (int) {
-        BigInteger return_value = *this;
-        --(*this);
-        return return_value;
-    }
- 
-    BigInteger& operator *= (const BigInteger& num) {
-        if (!(*this) || !num) {
-            data = {0};
-            is_negative = false;
-            return *this;
+    std::strong_ordering operator <=> (const BigFloat& num) const {
+        int sign = (mantissa.is_zero() ? 0 : (mantissa.is_negative ? -1 : 1));
+        int other_sign = (num.mantissa.is_zero() ? 0 : (num.mantissa.is_negative ? -1 : 1));
+        if (sign != other_sign || sign == 0) {
+            return sign <=> other_sign;
         }
-        if (num.is_negative) {
-            is_negative = !is_negative;
-        }
-        size_t deg2 = optimal_deg2(num.data.size());
-        size_t poly_size = static_cast<size_t>(1 << deg2);
-        std::vector<std::complex<long double>> poly = build_polynom(poly_size);
-        std::vector<std::complex<long double>> num_poly = num.build_polynom(poly_size);
-        polynom_multiplication(poly, num_poly, deg2);
-        fix_polynom(poly);
-        for (size_t i = 0; i < poly.size(); ++i) {
-            if (i == data.size()) {
-                data.push_back(static_cast<int>(poly[i].real() + half));
-            } else {
-                data[i] = static_cast<int>(poly[i].real() + half);
-            }
+        int64_t top = top_bit(mantissa, exponent);
+        int64_t other_top = top_bit(num.mantissa, num.exponent);
+        if (top != other_top) {
+            return (sign > 0 ? top <=> other_top : other_top <=> top);
         }
-        clean_trailing_zeros();
-        return *this;
+        if (exponent > num.exponent) {
+            return (mantissa << static_cast<size_t>(exponent - num.exponent)) <=> num.mantissa;
+        }
+        return mantissa <=> (num.mantissa << static_cast<size_t>(num.exponent - exponent));
     }
 
-    
-    BigInteger& operator /= (BigInteger num) {
-        bool negativeness = is_negative;
-        is_negative = false;
-        if (!(*this)) {
-            return *this;
-        }
-        if (num.is_negative) {
-            negativeness = !negativeness;
+    bool operator == (const BigFloat& num) const = default;
+
+    // correctly rounded to nearest, subnormals included; values beyond the double range give infinities
+    double to_double() const {
+        if (mantissa.is_zero()) {
+            return 0;
         }
-        num.is_negative = false;
-        BigInteger result = 0;
-        size_t num_digits_number = static_cast<size_t>(num.get_digits_number());
-        while (*this >= num) {
-            size_t digits_number = static_cast<size_t>(get_digits_number());
-            if (digits_number == num_digits_number) {
-                solve_first_division_case(num, result);
-            } else {
-                solve_second_division_case(num, result, digits_number, num_digits_number);
-            }
+        BigInteger rounded = mantissa;
+        int64_t rounded_exponent = exponent;
+        int64_t lowest_exponent = std::max<int64_t>(top_bit(mantissa, exponent) - 53, -1074);
+        round_to(rounded, rounded_exponent, lowest_exponent, RoundingMode::to_nearest);
+        if (rounded.is_zero()) {
+            return (mantissa.is_negative ? -0.0 : 0.0);
         }
-        *this = result;
-        clean_trailing_zeros();
-        is_negative = negativeness;
-        if (data.size() == 1 && data[0] == 0) {
-            is_negative = false;
+        if (rounded_exponent > 1024) {
+            return (mantissa.is_negative ? -HUGE_VAL : HUGE_VAL);
         }
-        return *this;
+        double value = std::ldexp(static_cast<double>(rounded.data[0]), static_cast<int>(rounded_exponent));
+        return (rounded.is_negative ? -value : value);
     }
 
-    BigInteger& operator %= (BigInteger num) {
-        bool negativeness = is_negative;
-        is_negative = false;
-        num.is_negative = false;
-        BigInteger copy = *this;
-        *this -= ((copy /= num) *= num);
-        is_negative = negativeness;
-        return *this;
+    explicit operator double() const {
+        return to_double();
     }
 
-    explicit operator bool() const {
-        return !is_zero();
+    explicit operator Rational() const {
+        if (exponent >= 0) {
+            return Rational(mantissa << static_cast<size_t>(exponent));
+        }
+        return Rational(mantissa) / Rational(BigInteger(1) << static_cast<size_t>(-exponent));
+    }
+
+    // the exact value truncated to precision decimal places
+    std::string asDecimal(size_t precision = 0) const {
+        return static_cast<Rational>(*this).asDecimal(precision);
     }
 
+    friend BigFloat sqrt(const BigFloat& num);
+    friend class ProductTree;
+
 };
 
-BigInteger operator + (const BigInteger& n1, const BigInteger& n2) {
-    BigInteger n1_copy = n1;
+BigFloat operator + (const BigFloat& n1, const BigFloat& n2) {
+    BigFloat n1_copy = n1;
     return n1_copy += n2;
 }
 
-BigInteger operator - (const BigInteger& n1, const BigInteger& n2) {
-    BigInteger n1_copy = n1;
+BigFloat operator - (const BigFloat& n1, const BigFloat& n2) {
+    BigFloat n1_copy = n1;
     return n1_copy -= n2;
 }
 
-BigInteger operator * (const BigInteger& n1, const BigInteger& n2) {
-    BigInteger n1_copy = n1;
+BigFloat operator * (const BigFloat& n1, const BigFloat& n2) {
+    BigFloat n1_copy = n1;
     return n1_copy *= n2;
 }
 
-BigInteger operator / (const BigInteger& n1, const BigInteger& n2) {
-    BigInteger n1_copy = n1;
+BigFloat operator / (const BigFloat& n1, const BigFloat& n2) {
+    BigFloat n1_copy = n1;
     return n1_copy /= n2;
 }
 
-BigInteger operator % (const BigInteger& n1, const BigInteger& n2) {
-    BigInteger n1_copy = n1;
-    return n1_copy %= n2;
-}
-
-BigInteger operator "" _bi(const char* chars) {
-    return BigInteger(std::string(chars, std::strlen(chars)));
-}
-
-BigInteger operator ""_bi(unsigned long long num) {
-    return BigInteger(std::to_string(num));
-}
-
-std::istream& operator >> (std::istream& input, BigInteger& num) {
-    std::string str;
-    input >> str;
-    num = BigInteger(str);
-    return input;
+// num must not be negative
+BigFloat sqrt(const BigFloat& num) {
+    return BigFloat::square_root(num);
 }
 
-std::ostream& operator << (std::ostream& output, const BigInteger& num) {
-    output << num.toString();
-    return output;
-}
+// Balanced products and binary splitting. A range of factors is multiplied as a tree, so every product has
+// operands of similar size and reaches the fast multiplication; subtrees at the top run on the BigInteger
+// thread pool, one per thread.
+class ProductTree {
 
-BigInteger abs(const BigInteger& num) {
-    if (num < 0) {
-        return -num;
-    }
-    return num;
-}
+public:
 
+    // one term a(n) / b(n) * p(first) * ... * p(n) / (q(first) * ... * q(n)) of a hypergeometric series
+    struct Term {
+        BigInteger a = 1;
+        BigInteger b = 1;
+        BigInteger p = 1;
+        BigInteger q = 1;
+    };
 
-class Rational {
+    // a range of terms: their sum is t / (b * q), p and q are the products of their p(n) and q(n)
+    struct Series {
+        BigInteger p;
+        BigInteger q;
+        BigInteger b;
+        BigInteger t;
+    };
 
 private:
 
-    BigInteger numerator;
-    BigInteger denominator;
-
-    constexpr static size_t number_precision = 12;
+    using limb = BigInteger::limb;
+    using double_limb = BigInteger::double_limb;
 
-    BigInteger gcd(const BigInteger& num1, const BigInteger& num2) {
-        if (!num2) {
-            return num1;
+    template<typename Node, typename Leaf, typename Combine>
+    static Node evaluate(size_t first, size_t last, const Leaf& leaf, const Combine& combine) {
+        if (last - first == 1) {
+            return leaf(first);
         }
-        return gcd(num2, num1 % num2);
-    }
-
-    void reduce() {
-        BigInteger greatest_common_divisor = gcd(abs(numerator), denominator);
-        numerator /= greatest_common_divisor;
-        denominator /= greatest_common_divisor;
-    }
-
-public:
-
-    Rational(): numerator(0), denominator(1) {}
-    // Rational(const Rational& other): numerator(other.numerator), denominator(other.denominator) {}
-    Rational(const BigInteger& n): numerator(n), denominator(1) {}
-    Rational(int number) {
-        *this = Rational(BigInteger(number));
+        size_t middle = first + (last - first) / 2;
+        return combine(evaluate<Node>(first, middle, leaf, combine), evaluate<Node>(middle, last, leaf, combine));
     }
 
-    auto operator <=> (const Rational& num) const {
-        if (numerator < 0 && num.numerator >= 0) {
-            return std::strong_ordering::less;
+    // the tree over [first, last) with its top split into one subtree per thread
+    template<typename Node, typename Leaf, typename Combine>
+    static Node evaluate_parallel(size_t first, size_t last, const Leaf& leaf, const Combine& combine) {
+        size_t count = last - first;
+        size_t parts = std::min(parallel_evaluation().threads, count / std::max<size_t>(parallel_evaluation().threshold, 1));
+        if (parts <= 1) {
+            return evaluate<Node>(first, last, leaf, combine);
         }
-        if (numerator >= 0 && num.numerator < 0) {
-            return std::strong_ordering::greater;
+        std::vector<Node> nodes(parts);
+        BigInteger::parallel_for(parts, parts, [&](size_t i) {
+            nodes[i] = evaluate<Node>(first + count * i / parts, first + count * (i + 1) / parts, leaf, combine);
+        });
+        // the few remaining levels are large products, which parallelize inside the multiplication
+        while (nodes.size() > 1) {
+            std::vector<Node> next;
+            for (size_t i = 0; i + 1 < nodes.size(); i += 2) {
+                next.push_back(combine(nodes[i], nodes[i + 1]));
+            }
+            if (nodes.size() % 2 != 0) {
+                next.push_back(std::move(nodes.back()));
+            }
+            nodes = std::move(next);
         }
-        BigInteger left = numerator * num.denominator;
-        BigInteger right = denominator * num.numerator;
-        return left <=> right;
+        return std::move(nodes[0]);
     }
 
-    bool operator == (const Rational& num) const = default;
+    static BigInteger multiply(const BigInteger& n1, const BigInteger& n2) {
+        return n1 * n2;
+    }
 
-    std::string toString() const {
-        std::string res = numerator.toString();
-        if (denominator != 1) {
-            res += "/" + denominator.toString();
+    // the odd parts of first, ..., last - 1 multiplied greedily into limbs, their powers of two counted in twos
+    static std::vector<limb> packed_odd_parts(uint64_t first, uint64_t last, size_t& twos) {
+        std::vector<limb> packed;
+        limb current = 1;
+        twos = 0;
+        for (uint64_t i = first; i < last; ++i) {
+            int zero_bits = std::countr_zero(i);
+            twos += static_cast<size_t>(zero_bits);
+            double_limb next = static_cast<double_limb>(current) * (i >> zero_bits);
+            if ((next >> BigInteger::limb_bits) != 0) {
+                packed.push_back(current);
+                current = i >> zero_bits;
+            } else {
+                current = static_cast<limb>(next);
+            }
         }
-        return res;
+        packed.push_back(current);
+        return packed;
     }
 
-    // Rational& operator = (const Rational& num) = default;
+public:
 
-    Rational operator - () const {
-        Rational copy = *this;
-        copy.numerator.change_sign();
-        return copy;
+    // threads for the top subtrees, and the leaves a subtree needs to get a thread of its own
+    struct ParallelEvaluation {
+        size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+        size_t threshold = 256;
+    };
+
+    static ParallelEvaluation& parallel_evaluation() {
+        static ParallelEvaluation settings;
+        return settings;
     }
 
-    Rational& operator += (const Rational& num) {
-        numerator = numerator * num.denominator + denominator * num.numerator;
-        denominator = denominator * num.denominator;
-        reduce();
-        return *this;
+    // the product of the BigIntegers in [first, last) for random access iterators
+    template<typename Iterator>
+    static BigInteger product(Iterator first, Iterator last) {
+        if (first == last) {
+            return 1;
+        }
+        return evaluate_parallel<BigInteger>(0, static_cast<size_t>(last - first), [first](size_t i) {
+            return BigInteger(first[i]);
+        }, multiply);
     }
 
-    Rational& operator -= (const Rational& num) {
-        return *this += -num;
+    // first * (first + 1) * ... * (last - 1), 1 for an empty range
+    static BigInteger product_range(uint64_t first, uint64_t last) {
+        if (first >= last) {
+            return 1;
+        }
+        if (first == 0) {
+            return 0;
+        }
+        size_t twos;
+        std::vector<limb> packed = packed_odd_parts(first, last, twos);
+        BigInteger result = evaluate_parallel<BigInteger>(0, packed.size(), [&packed](size_t i) {
+            return BigInteger::from_limbs({packed[i]});
+        }, multiply);
+        result <<= twos;
+        return result;
     }
 
-    Rational& operator *= (const Rational& num) {
-        numerator *= num.numerator;
-        denominator *= num.denominator;
-        reduce();
-        return *this;
+    static BigInteger factorial(uint64_t n) {
+        return product_range(1, n + 1);
     }
 
-    Rational& operator /= (const Rational& num) {
-        numerator *= num.denominator;
-        denominator *= num.numerator;
-        if (denominator < 0) {
-            numerator.change_sign();
-            denominator.change_sign();
+    // n! / (k! (n - k)!) as the product of the top k factors of n! divided by k!
+    static BigInteger binomial(uint64_t n, uint64_t k) {
+        if (k > n) {
+            return 0;
         }
-        reduce();
-        return *this;
+        k = std::min(k, n - k);
+        return product_range(n - k + 1, n + 1) / product_range(1, k + 1);
     }
 
-    std::string asDecimal(size_t precision = 0) const {
-        BigInteger shifted_numerator = numerator;
-        shifted_numerator.shift(precision);
-        std::string result = (shifted_numerator / denominator).toString();
-        if (precision != 0) {
-            size_t digits_number = (result[0] == '-' ? result.size() - 1 : result.size());
-            if (digits_number <= precision) {
-                std::string zeros = (numerator < 0 ? "-0." : "0.");
-                for (size_t i = 0; i < precision - digits_number; ++i) {
-                    zeros.push_back('0');
-                }
-                if (result[0] == '-') {
-                    result.erase(result.begin());
-                }
-                result = zeros + result;
-            } else {
-                size_t position = result.size() - precision;
-                result.insert(result.begin() + static_cast<int>(position), '.');
-            }
+    // terms first, ..., last - 1 of the series given by term(n), which returns a Term; last must exceed first
+    template<typename TermOf>
+    static Series binary_splitting(uint64_t first, uint64_t last, TermOf term) {
+        return evaluate_parallel<Series>(0, static_cast<size_t>(last - first), [first, &term](size_t i) {
+            Term leaf = term(first + i);
+            BigInteger t = leaf.a * leaf.p;
+            return Series{std::move(leaf.p), std::move(leaf.q), std::move(leaf.b), std::move(t)};
+        }, [](const Series& left, const Series& right) {
+            return Series{left.p * right.p, left.q * right.q, left.b * right.b,
+                          right.b * right.q * left.t + left.b * left.p * right.t};
+        });
+    }
+
+    // e = sum 1 / n! to the BigFloat precision, the truncated tail is below 2^-(precision + 16)
+    static BigFloat e() {
+        double bits = static_cast<double>(BigFloat::context().precision + 16);
+        uint64_t terms = 1;
+        for (double log_factorial = 0; log_factorial < bits; log_factorial += std::log2(static_cast<double>(terms))) {
+            ++terms;
         }
-        return result;
+        Series sum = binary_splitting(0, terms, [](uint64_t n) {
+            Term term;
+            if (n > 0) {
+                term.q = BigInteger::from_int64(static_cast<int64_t>(n));
+            }
+            return term;
+        });
+        return BigFloat::quotient(sum.t, 0, sum.b * sum.q, 0);
     }
 
-    explicit operator double() const {
-        return std::stod(asDecimal(number_precision));
+    // Chudnovsky's series, about 47 bits per term; within a few units in the last place
+    static BigFloat pi() {
+        uint64_t terms = BigFloat::context().precision / 47 + 2;
+        BigInteger cube_over_24 = BigInteger(640320) * BigInteger(640320) * BigInteger(640320) / 24;
+        Series sum = binary_splitting(0, terms, [&cube_over_24](uint64_t n) {
+            Term term;
+            int64_t k = static_cast<int64_t>(n);
+            term.a = BigInteger::from_int64(545140134) * k + BigInteger(13591409);
+            if (k > 0) {
+                term.p = BigInteger::from_int64(-(6 * k - 5)) * (2 * k - 1) * (6 * k - 1);
+                term.q = BigInteger::from_int64(k) * k * k * cube_over_24;
+            }
+            return term;
+        });
+        BigFloat root = BigFloat(426880) * sqrt(BigFloat(10005));
+        return root * BigFloat::quotient(sum.b * sum.q, 0, sum.t, 0);
     }
 
 };
 
-Rational operator + (const Rational& n1, const Rational& n2) {
-    Rational n1_copy = n1;
-    return n1_copy += n2;
-}
-
-Rational operator - (const Rational& n1, const Rational& n2) {
-    Rational n1_copy = n1;
-    return n1_copy -= n2;
+BigInteger factorial(uint64_t n) {
+    return ProductTree::factorial(n);
 }
 
-Rational operator * (const Rational& n1, const Rational& n2) {
-    Rational n1_copy = n1;
-    return n1_copy *= n2;
-}
-
-Rational operator / (const Rational& n1, const Rational& n2) {
-    Rational n1_copy = n1;
-    return n1_copy /= n2;
+BigInteger binomial(uint64_t n, uint64_t k) {
+    return ProductTree::binomial(n, k);
 }